@@ -109,36 +109,41 @@ int main() {
 		skin->setColor( (irr::gui::EGUI_DEFAULT_COLOR)c, color );
 	}
 
-	Cu::FileInStream  cfistream("main.cu");
-	Lg logger(cfistream);
-	Cu::Engine  cuengine;
-	cuengine.setLogger(&logger);
-
-	cubr::EventHandler ceh(cuengine);
-	device->setEventReceiver(&ceh);
-
-	cubr::CuBridge::InitFlags initflags;
-	initflags.enableImageModifying = true;
-	cubr::CuBridge  cubridge = cubr::CuBridge(cuengine, device->getGUIEnvironment(), nullptr, initflags);
-	AppCuInterface  aci(cuengine, device);
-	Cu::Numeric::addFunctionsToEngine(cuengine);
-
-	Cu::EngineResult::Value  erv;
-	do {
-		erv = cuengine.run(cfistream);
-	} while ( erv == Cu::EngineResult::Ok );
-	if ( erv == Cu::EngineResult::Error ) {
-		device->closeDevice();
-		device->drop();
-		return 1;
-	}
+	int  result = 0;
+	// The bridge and engine are destroyed before the device, since they hold its GUI environment and textures
+	{
+		Cu::FileInStream  cfistream("main.cu");
+		Lg logger(cfistream);
+		Cu::Engine  cuengine;
+		cuengine.setLogger(&logger);
+
+		cubr::EventHandler ceh(cuengine);
+		device->setEventReceiver(&ceh);
+
+		cubr::CuBridge::InitFlags initflags;
+		initflags.enableImageModifying = true;
+		cubr::CuBridge  cubridge(cuengine, device->getGUIEnvironment(), nullptr, initflags);
+		AppCuInterface  aci(cuengine, device);
+		Cu::Numeric::addFunctionsToEngine(cuengine);
+
+		Cu::EngineResult::Value  erv;
+		do {
+			erv = cuengine.run(cfistream);
+		} while ( erv == Cu::EngineResult::Ok );
+		if ( erv == Cu::EngineResult::Error ) {
+			device->closeDevice();
+			result = 1;
+		}
 
-	while ( device->run() ) {
-		device->getVideoDriver()->beginScene();
-		device->getGUIEnvironment()->drawAll();
-		device->getVideoDriver()->endScene();
+		while ( result == 0 && device->run() ) {
+			device->getVideoDriver()->beginScene();
+			device->getGUIEnvironment()->drawAll();
+			device->getVideoDriver()->endScene();
+		}
 	}
 
+	// The event handler is gone
+	device->setEventReceiver(0);
 	device->drop();
-	return 0;
+	return result;
 }
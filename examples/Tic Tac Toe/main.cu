@@ -121,15 +121,22 @@ app = [
 getGameImage = [imageName] {
 	ret(get_texture(concat("./img/" imageName: ".png")))
 }
-getCloseImage = { ret(getGameImage("exit")) }
-getSaveGameImage = { ret(getGameImage("save")) }
-getLoadGameImage = { ret(getGameImage("load")) }
-getNewGameImage = { ret(getGameImage("new")) }
-getHumanvsHumanImage = { ret(getGameImage("human_vs_human")) }
-getAIvsHumanImage = { ret(getGameImage("ai_vs_human")) }
-getEmptySlotImage = { ret(getGameImage("q")) }
-getOSlotImage = { ret(getGameImage("circle")) }
-getXSlotImage = { ret(getGameImage("x")) }
+# The button images share one texture. Each file is only packed once. #
+buttonAtlas = atlas_create(512)
+getButtonImage = [imageName] {
+	ret(atlas_add(buttonAtlas: concat("./img/" imageName: ".png")))
+}
+getCloseImage = { ret(getButtonImage("exit")) }
+getSaveGameImage = { ret(getButtonImage("save")) }
+getLoadGameImage = { ret(getButtonImage("load")) }
+getNewGameImage = { ret(getButtonImage("new")) }
+getHumanvsHumanImage = { ret(getButtonImage("human_vs_human")) }
+getAIvsHumanImage = { ret(getButtonImage("ai_vs_human")) }
+getEmptySlotImage = { ret(getButtonImage("q")) }
+getOSlotImage = { ret(getButtonImage("circle")) }
+getXSlotImage = { ret(getButtonImage("x")) }
+# The banners are not shown until a game ends, so they are decoded in the background #
+texture_preload("./img/player2wins.png" "./img/draw.png")
 getPlayer1WinsBanner = { ret(getGameImage("player1wins")) }
 getPlayer2WinsBanner = { ret(getGameImage("player2wins")) }
 getDrawBanner = { ret(getGameImage("draw")) }
@@ -251,6 +258,12 @@ buildGUI = {
 
 	pos = movedVectX(pos shift)
 	makeMenuAIDropDown(pos size app.AILevelID mainMenuBar)
+	# The bridge routes the drop-down's events straight to this callback #
+	gui_on(gui_child_with_id(mainMenuBar: app.AILevelID:) "combobox change" [elem_id other_id event]{
+		gameSettings.AIlevel = +(1 event_get(event: "value"))
+		resetGame:
+		ret(true)
+	})
 
 	makeGameBoard:
 
@@ -646,6 +659,9 @@ runAI = [
 	}
 }
 
+# The AI move runs in the click callback, so it is left to the main loop rather than run within the event #
+gui_coalesce("button click" "deferred")
+
 gui_on_button_clicked([elem_id]{
 	assert(are_int(elem_id:))
 
@@ -691,17 +707,6 @@ gui_on_button_clicked([elem_id]{
 	ret(false)
 })
 
-gui_on_combobox_changed([elem_id]{
-	if ( equal(elem_id: app.AILevelID:) ) {
-		e = gui_child_with_id(mainMenuBar: app.AILevelID:)
-		v = gui_value(e:)
-		gameSettings.AIlevel = +(1 v.Selected:)
-		resetGame:
-		ret(true)
-	}
-	ret(false)
-})
-
 #gui_on_listbox_changed([elem_id]{
 	if ( equal(elem_id: app.AILevelID:) ) {
 		e = gui_child_with_id(mainMenuBar: app.AILevelID:)
@@ -111,33 +111,42 @@ int main() {
 		skin->setColor( (irr::gui::EGUI_DEFAULT_COLOR)c, color );
 	}
 
-	Cu::FileInStream  cfistream("main.cu");
-	Lg logger(cfistream);
-	Cu::Engine  cuengine;
-	cuengine.setLogger(&logger);
-
-	cubr::EventHandler ceh(cuengine);
-	device->setEventReceiver(&ceh);
-
-	cubr::CuBridge  cubridge = cubr::CuBridge(cuengine, device->getGUIEnvironment(), nullptr);
-	AppCuInterface  aci(cuengine, device);
-
-	Cu::EngineResult::Value  erv;
-	do {
-		erv = cuengine.run(cfistream);
-	} while ( erv == Cu::EngineResult::Ok );
-	if ( erv == Cu::EngineResult::Error ) {
-		device->closeDevice();
-		device->drop();
-		return 1;
-	}
+	int  result = 0;
+	// The bridge and engine are destroyed before the device, since they hold its GUI environment and textures
+	{
+		Cu::FileInStream  cfistream("main.cu");
+		Lg logger(cfistream);
+		Cu::Engine  cuengine;
+		cuengine.setLogger(&logger);
+
+		cubr::EventHandler ceh(cuengine);
+		device->setEventReceiver(&ceh);
+
+		cubr::CuBridge  cubridge(cuengine, device->getGUIEnvironment(), nullptr);
+		cubridge.setEventQueue(&ceh.getEventQueue());
+		cubridge.installEventRouter(&ceh);
+		AppCuInterface  aci(cuengine, device);
+
+		Cu::EngineResult::Value  erv;
+		do {
+			erv = cuengine.run(cfistream);
+		} while ( erv == Cu::EngineResult::Ok );
+		if ( erv == Cu::EngineResult::Error ) {
+			device->closeDevice();
+			result = 1;
+		}
 
-	while ( device->run() ) {
-		device->getVideoDriver()->beginScene();
-		device->getGUIEnvironment()->drawAll();
-		device->getVideoDriver()->endScene();
+		while ( result == 0 && device->run() ) {
+			cubridge.pumpLoads(4);
+			ceh.pump(4000);
+			device->getVideoDriver()->beginScene();
+			device->getGUIEnvironment()->drawAll();
+			device->getVideoDriver()->endScene();
+		}
 	}
 
+	// The event handler is gone
+	device->setEventReceiver(0);
 	device->drop();
-	return 0;
+	return result;
 }
@@ -0,0 +1,72 @@
+--[[ Benchmark project file
+(c) 2026 Nicolaus Anderson
+Runs on the Irrlicht null driver, so no window is opened.
+Run from this folder: ./bench.out [workload.cu ...]
+]]
+
+local v_cubr_path = "../../src/"
+local v_copper_path = "../../../CopperLang/Copper/src/"
+local v_copper_stdlib_path = "../../../CopperLang/Copper/stdlib/"
+local v_irrext_path = "../../../../Irrlicht/IrrExtensions/"
+local v_irrlicht_home = "/usr/local"
+local v_irrlicht_include = "/usr/local/include/irrlicht/"
+
+-- "make" paths
+local v_b_cubr_path = "../" .. v_cubr_path
+local v_b_copper_path = "../" .. v_copper_path
+local v_b_copper_stdlib_path = "../" .. v_copper_stdlib_path
+local v_b_irrext_path = "../" .. v_irrext_path
+
+workspace "CuBridge Bench"
+	configurations { "release" }
+	location "build"
+	objdir "build/obj"
+	targetdir "."
+	optimize "Speed"
+	filter { "action:gmake" }
+		-- Add -mavx2 to build the AVX2 image kernels (see cubr_imgkern.h)
+		buildoptions " -Wfatal-errors -Wall"
+
+project "bench"
+	targetname "bench.out"
+	language "C++"
+	cppdialect "C++11"
+	kind "ConsoleApp"
+	links {
+		"Irrlicht",
+		"GL",
+		"Xxf86vm",
+		"Xext",
+		"X11",
+		"Xcursor",
+		"pthread" -- Image jobs (cubr_threadpool.h)
+	}
+	defines { "SYSTEM=Linux", "INCLUDE_CUBR_JSON" }
+	files {
+		"src/**.h"
+		, "src/**.cpp"
+		, v_cubr_path .. "**.h"
+		, v_cubr_path .. "**.cpp"
+		, v_copper_path .. "**.h"
+		, v_copper_path .. "**.cpp"
+		, v_copper_stdlib_path .. "**.h"
+		, v_copper_stdlib_path .. "**.cpp"
+		, v_irrext_path .. "util/irrTree/irrTree.cpp"
+		, v_irrext_path .. "util/irrJSON/irrJSON.cpp"
+	}
+	removefiles {
+		v_cubr_path .. "excludes/**.h"
+		, v_cubr_path .. "excludes/**.cpp"
+	}
+	buildoptions {
+		"-I" .. v_b_cubr_path
+		, "-I" .. v_b_copper_path
+		, "-I" .. v_b_copper_stdlib_path
+		, "-I" .. v_irrlicht_include
+		, "-I" .. v_b_irrext_path
+		, "-I" .. v_b_irrext_path .. "./util/irrTree"
+		, "-I" .. v_b_irrext_path .. "./util/irrJSON"
+	}
+	linkoptions {
+		" -L" .. v_irrlicht_home .. "/lib"
+	}
@@ -0,0 +1,329 @@
+// (C) 2026 Nicolaus Anderson
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <new>
+#include <atomic>
+#include <Copper.h>
+#include <FileInStream.h>
+#include <EngMsgToStr.h>
+#include <irrlicht.h>
+#include "../../../src/cubridge.h"
+#include "../../../src/cubr_mfrunner.h"
+#include "../../../src/cubr_imgkern.h"
+#include "../../../src/cubr_pixfmt.h"
+#include <vector>
+
+using Cu::ForeignFunc;
+
+// Allocation counting
+// Every operator new in the program passes through here, so allocs/op includes Copper, Irrlicht and CuBridge.
+// The image thread pool allocates too, so the count is atomic.
+static std::atomic<size_t>  allocationCount(0);
+
+void* operator new( std::size_t  size ) {
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	void*  p = std::malloc( size ? size : 1 );
+	if ( !p )
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete( void*  p ) noexcept {
+	std::free(p);
+}
+
+struct Lg : public Cu::Logger {
+	virtual void print(const Cu::LogLevel::Value  logLevel, const char*  msg) {
+		switch(logLevel) {
+		case Cu::LogLevel::warning:
+			std::printf("Warning: %s\n", msg);
+			break;
+		case Cu::LogLevel::error:
+			std::printf("ERROR: %s\n", msg);
+			break;
+		default:
+			std::printf("%s\n", msg);
+			break;
+		}
+	}
+
+	virtual void print(const Cu::LogLevel::Value  logLevel, const Cu::EngineMessage::Value  msg) {
+		Cu::EngineErrorLevel::Value  errLevel;
+		print(logLevel, Cu::getStringFromEngineMessage(msg, errLevel));
+	}
+
+	virtual void print(Cu::LogMessage  logMsg) {
+		Cu::EngineErrorLevel::Value  errLevel;
+		util::String  fullMsg = "In function ";
+
+		fullMsg += logMsg.functionName;
+		fullMsg += ": ";
+		fullMsg += Cu::getStringFromEngineMessage(logMsg.messageId, errLevel);
+
+		print(logMsg.level, fullMsg.c_str());
+	}
+
+	virtual void printTaskTrace( Cu::TaskType::Value, const util::String&, Cu::UInteger ) {}
+
+	virtual void printStackTrace( const Cu::String&, Cu::UInteger ) {}
+};
+
+//! Benchmark timer
+// bench_start( "label" count ) / bench_stop()
+// Prints the time and allocations per operation between the two calls.
+class BenchTimer {
+	typedef  std::chrono::steady_clock  clock_t;
+
+	util::String  label;
+	Cu::Integer  count;
+	clock_t::time_point  startTime;
+	size_t  startAllocations;
+
+public:
+	BenchTimer()
+		: label()
+		, count(1)
+		, startTime()
+		, startAllocations(0)
+	{}
+
+	void
+	begin( const util::String&  name, Cu::Integer  n ) {
+		label = name;
+		count = n > 0 ? n : 1;
+		startAllocations = allocationCount.load(std::memory_order_relaxed);
+		startTime = clock_t::now();
+	}
+
+	void
+	end() {
+		const clock_t::time_point  endTime = clock_t::now();
+		const double  allocs = (double)(allocationCount.load(std::memory_order_relaxed) - startAllocations);
+		const double  ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds>( endTime - startTime ).count();
+		std::printf("%-40s %12.1f ns/op %10.2f allocs/op\n", label.c_str(), ns / (double)count, allocs / (double)count);
+	}
+
+	ForeignFunc::Result
+	start( Cu::FFIServices&, Cu::StringObject&  name, Cu::NumericObject&  n ) {
+		begin( name.getString(), n.getIntegerValue() );
+		return ForeignFunc::FINISHED;
+	}
+
+	ForeignFunc::Result
+	stop( Cu::FFIServices& ) {
+		end();
+		return ForeignFunc::FINISHED;
+	}
+};
+
+//! The work of gui_visible(), with arguments checked by hand and by bindFFI()
+class VisibleHost {
+public:
+	ForeignFunc::Result
+	manual( Cu::FFIServices&  ffi ) {
+		if ( !ffi.demandArgCountRange(1,2)
+			|| !ffi.demandArgType(0, cubr::GUIElement::getTypeAsCuType())
+		) {
+			return ForeignFunc::NONFATAL;
+		}
+		cubr::GUIElement&  elem = (cubr::GUIElement&)ffi.arg(0);
+
+		if ( ffi.getArgCount() == 2 ) {
+			if ( !ffi.demandArgType(1, Cu::ObjectType::Bool) )
+				return ForeignFunc::NONFATAL;
+
+			elem.setVisible( (Cu::BoolObject&)ffi.arg(1) );
+		} else {
+			ffi.setNewResult( new Cu::BoolObject( elem.isVisible() ) );
+		}
+		return ForeignFunc::FINISHED;
+	}
+
+	ForeignFunc::Result
+	bound( Cu::FFIServices&  ffi, cubr::GUIElement&  elem, cubr::Optional<Cu::BoolObject&>  setting ) {
+		if ( setting.isSet() ) {
+			elem.setVisible( setting.get() );
+		} else {
+			ffi.setNewResult( new Cu::BoolObject( elem.isVisible() ) );
+		}
+		return ForeignFunc::FINISHED;
+	}
+};
+
+// Runs the workload script with a new engine and bridge
+static bool
+runWorkload( irr::IrrlichtDevice*  device, const char*  scriptPath ) {
+	Lg  logger;
+	Cu::Engine  cuengine;
+	cuengine.setLogger(&logger);
+
+	cubr::CuBridge::InitFlags  flags;
+	flags.enableImageModifying = true;
+	flags.enableJSON = true;
+	cubr::CuBridge  cubridge(cuengine, device->getGUIEnvironment(), nullptr, flags);
+
+	BenchTimer  timer;
+	VisibleHost  visibleHost;
+	cubr::bindFFI(cuengine, "bench_start", &timer, &BenchTimer::start);
+	cubr::bindFFI(cuengine, "bench_stop", &timer, &BenchTimer::stop);
+	Cu::addForeignMethodInstance<VisibleHost>(cuengine, "bench_visible_manual", &visibleHost, &VisibleHost::manual);
+	cubr::bindFFI(cuengine, "bench_visible_bound", &visibleHost, &VisibleHost::bound);
+
+	std::printf("-- %s\n", scriptPath);
+	Cu::FileInStream  script(scriptPath);
+	Cu::EngineResult::Value  erv;
+	do {
+		erv = cuengine.run(script);
+	} while ( erv == Cu::EngineResult::Ok );
+
+	device->getGUIEnvironment()->clear();
+	return erv != Cu::EngineResult::Error;
+}
+
+// Runs a project of imported files through the MultifileRunner the given number of times
+static bool
+runImports( irr::IrrlichtDevice*  device, Cu::Integer  count ) {
+	Lg  logger;
+	Cu::Engine  cuengine;
+	cuengine.setLogger(&logger);
+	cubr::CuBridge  cubridge(cuengine, device->getGUIEnvironment(), nullptr);
+	BenchTimer  timer;
+	bool  ok = true;
+	Cu::Integer  i = 0;
+
+	std::printf("-- MultifileRunner\n");
+	timer.begin("MultifileRunner, 4 imports", count);
+	for (; i < count && ok; ++i) {
+		cubr::MultifileRunner  runner(cuengine);
+		runner.setRootDirectoryPath("workloads/imports");
+		ok = runner.run("project.cu");
+	}
+	timer.end();
+
+	device->getGUIEnvironment()->clear();
+	return ok;
+}
+
+// Compares the SIMD and scalar image kernels on a span of pixels
+// Blits and conversions have no SIMD kernel, so they compare the paths image_blit() and image_convert() choose between.
+static void
+runKernels( irr::u32  count, Cu::Integer  repeat ) {
+	std::vector<irr::u32>  dst(count), src(count);
+	std::vector<irr::u32>  row(count);
+	std::vector<irr::u8>  packed(count * 3);
+	BenchTimer  timer;
+	util::String  simd = cubr::getImageKernelPath();
+	util::String  label;
+	irr::u32  i;
+	Cu::Integer  r;
+
+	for ( i = 0; i < count; ++i )
+		src[i] = (i * 2654435761u) ^ 0x80000000;
+
+	std::printf("-- Image kernels, %u pixels per op\n", count);
+
+	label = "fillSpanARGB, ";
+	label += simd;
+	timer.begin( label, repeat );
+	for ( r = 0; r < repeat; ++r )
+		cubr::fillSpanARGB( &dst[0], count, (irr::u32)r );
+	timer.end();
+
+	timer.begin( "fillSpanARGB, scalar", repeat );
+	for ( r = 0; r < repeat; ++r )
+		cubr::fillSpanARGBScalar( &dst[0], count, (irr::u32)r );
+	timer.end();
+
+	label = "blendSpanARGB, ";
+	label += simd;
+	timer.begin( label, repeat );
+	for ( r = 0; r < repeat; ++r )
+		cubr::blendSpanARGB( &dst[0], &src[0], count, 200 );
+	timer.end();
+
+	timer.begin( "blendSpanARGB, scalar", repeat );
+	for ( r = 0; r < repeat; ++r )
+		cubr::blendSpanARGBScalar( &dst[0], &src[0], count, 200 );
+	timer.end();
+
+	label = "premultiplySpanARGB, ";
+	label += simd;
+	timer.begin( label, repeat );
+	for ( r = 0; r < repeat; ++r ) {
+		dst = src;
+		cubr::premultiplySpanARGB( &dst[0], count );
+	}
+	timer.end();
+
+	timer.begin( "premultiplySpanARGB, scalar", repeat );
+	for ( r = 0; r < repeat; ++r ) {
+		dst = src;
+		cubr::premultiplySpanARGBScalar( &dst[0], count );
+	}
+	timer.end();
+
+	// Rows of the same format are moved whole, otherwise each pixel goes through A8R8G8B8
+	timer.begin( "blit, memmove", repeat );
+	for ( r = 0; r < repeat; ++r )
+		std::memmove( &dst[0], &src[0], count * sizeof(irr::u32) );
+	timer.end();
+
+	timer.begin( "blit, R5G6B5 to A8R8G8B8, scalar", repeat );
+	for ( r = 0; r < repeat; ++r ) {
+		cubr::readPixelsARGB( &src[0], irr::video::ECF_R5G6B5, &row[0], count );
+		cubr::writePixelsARGB( &row[0], irr::video::ECF_A8R8G8B8, &dst[0], count );
+	}
+	timer.end();
+
+	timer.begin( "convert A8R8G8B8 to R8G8B8, scalar", repeat );
+	for ( r = 0; r < repeat; ++r )
+		cubr::writePixelsARGB( &src[0], irr::video::ECF_R8G8B8, &packed[0], count );
+	timer.end();
+
+	timer.begin( "convert R8G8B8 to A8R8G8B8, scalar", repeat );
+	for ( r = 0; r < repeat; ++r )
+		cubr::readPixelsARGB( &packed[0], irr::video::ECF_R8G8B8, &dst[0], count );
+	timer.end();
+
+	timer.begin( "convert A8R8G8B8 to R5G6B5, scalar", repeat );
+	for ( r = 0; r < repeat; ++r )
+		cubr::writePixelsARGB( &src[0], irr::video::ECF_R5G6B5, &packed[0], count );
+	timer.end();
+}
+
+int main( int argc, char* argv[] ) {
+	const char*  defaultWorkloads[] = {
+		"workloads/create.cu",
+		"workloads/attrs.cu",
+		"workloads/toggle.cu",
+		"workloads/pixels.cu",
+		"workloads/images.cu",
+		"workloads/jobs.cu",
+		"workloads/atlas.cu",
+		"workloads/json.cu",
+		"workloads/ffi.cu"
+	};
+	bool  ok = true;
+	int  i;
+
+	irr::IrrlichtDevice*  device = irr::createDevice(irr::video::EDT_NULL);
+	if ( !device ) {
+		return 1;
+	}
+
+	if ( argc > 1 ) {
+		for ( i = 1; i < argc; ++i )
+			ok = runWorkload(device, argv[i]) && ok;
+	} else {
+		for ( i = 0; i < (int)(sizeof(defaultWorkloads) / sizeof(defaultWorkloads[0])); ++i )
+			ok = runWorkload(device, defaultWorkloads[i]) && ok;
+		ok = runImports(device, 100) && ok;
+		runKernels(256 * 256, 200);
+	}
+
+	device->drop();
+	return ok ? 0 : 1;
+}
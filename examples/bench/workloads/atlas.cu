@@ -0,0 +1,22 @@
+# Packing many small images into an atlas #
+
+n = 20
+count = 64
+icon = image_create(40 40 "A8R8G8B8")
+image_fill(icon: [ red = 200 green = 80 blue = 20 alpha = 255 ])
+
+bench_start("atlas_add 64 40x40 images + atlas_commit" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	atlas = atlas_create(512)
+	k = 0
+	loop {
+		if ( gte(k: count:) ) { stop }
+		atlas_add(atlas: icon:)
+		++(k:)
+	}
+	atlas_commit(atlas:)
+	++(i:)
+}
+bench_stop()
@@ -0,0 +1,65 @@
+# gui_attrs() get and set for each stock element type #
+
+n = 200
+
+round_trip = [type count] {
+	elem = gui_create(type:)
+	bench_start(concat("gui_attrs round trip, " type:) count:)
+	i = 0
+	loop {
+		if ( gte(i: count:) ) { stop }
+		gui_attrs(elem: gui_attrs(elem:))
+		++(i:)
+	}
+	bench_stop()
+}
+
+round_trip("element" n:)
+round_trip("button" n:)
+round_trip("checkBox" n:)
+round_trip("comboBox" n:)
+round_trip("contextMenu" n:)
+round_trip("menu" n:)
+round_trip("editBox" n:)
+round_trip("image" n:)
+round_trip("listBox" n:)
+round_trip("scrollBar" n:)
+round_trip("spinBox" n:)
+round_trip("staticText" n:)
+round_trip("tab" n:)
+round_trip("tabControl" n:)
+round_trip("table" n:)
+round_trip("toolBar" n:)
+round_trip("treeview" n:)
+round_trip("window" n:)
+
+elem = gui_create("checkBox")
+
+bench_start("gui_attrs projection, checkBox" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_attrs(elem: "Checked" "Caption")
+	++(i:)
+}
+bench_stop()
+
+bench_start("gui_value get, checkBox" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_value(elem:)
+	++(i:)
+}
+bench_stop()
+
+checked = [ Checked = true ]
+
+bench_start("gui_set, checkBox" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_set(elem: checked:)
+	++(i:)
+}
+bench_stop()
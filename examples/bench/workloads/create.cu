@@ -0,0 +1,35 @@
+# Element creation through the GUI element factory #
+
+n = 10000
+
+bench_start("gui_create button" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_create("button")
+	++(i:)
+}
+bench_stop()
+
+attrs = [
+	Caption = "Bench"
+	Visible = true
+]
+
+bench_start("gui_create button, attributes" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_create("button" attrs:)
+	++(i:)
+}
+bench_stop()
+
+bench_start("gui_new_empty" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_new_empty()
+	++(i:)
+}
+bench_stop()
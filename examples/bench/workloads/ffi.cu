@@ -0,0 +1,50 @@
+# Foreign function call overhead
+Compares the same work done by a method that checks its own arguments (as CuBridge used to)
+with one bound via bindFFI(). #
+
+n = 200000
+elem = gui_new_empty()
+
+bench_start("loop only" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	++(i:)
+}
+bench_stop()
+
+bench_start("visible, checked by hand" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	bench_visible_manual(elem: true)
+	++(i:)
+}
+bench_stop()
+
+bench_start("visible, bindFFI" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	bench_visible_bound(elem: true)
+	++(i:)
+}
+bench_stop()
+
+bench_start("gui_visible" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_visible(elem: true)
+	++(i:)
+}
+bench_stop()
+
+bench_start("gui_text get" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_text(elem:)
+	++(i:)
+}
+bench_stop()
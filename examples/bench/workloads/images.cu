@@ -0,0 +1,87 @@
+# Whole image operations #
+
+w = 256
+h = 256
+n = 50
+dest = image_create(w: h: "A8R8G8B8")
+badge = image_create(64 64 "A8R8G8B8")
+image_fill(badge: [ red = 250 green = 20 blue = 20 alpha = 180 ])
+fill_color = [ red = 32 green = 64 blue = 96 alpha = 255 ]
+
+bench_start("image_fill 256x256" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_fill(dest: fill_color:)
+	++(i:)
+}
+bench_stop()
+
+bench_start("image_blit 256x256" n:)
+src = image_create(w: h: "A8R8G8B8")
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_blit(dest: src: 0 0)
+	++(i:)
+}
+bench_stop()
+
+bench_start("image_blend badge 64x64" *(n: 10))
+i = 0
+loop {
+	if ( gte(i: *(n: 10)) ) { stop }
+	image_blend(dest: badge: 180 10 200)
+	++(i:)
+}
+bench_stop()
+
+bench_start("image_premultiply 256x256" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_premultiply(dest:)
+	++(i:)
+}
+bench_stop()
+
+bench_start("image_convert 256x256 to R5G6B5" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_convert(dest: "R5G6B5")
+	++(i:)
+}
+bench_stop()
+
+preview = image_to_texture(dest: "bench preview")
+bench_start("image_fill_rect 16x16 + texture_update" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_fill_rect(dest: i: i: +(i: 16) +(i: 16) fill_color:)
+	texture_update(preview: dest:)
+	++(i:)
+}
+bench_stop()
+
+bench_start("texture_lock + image_fill_rect 16x16 + texture_unlock" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	view = texture_lock(preview:)
+	image_fill_rect(view: i: i: +(i: 16) +(i: 16) fill_color:)
+	texture_unlock(preview:)
+	++(i:)
+}
+bench_stop()
+
+bench_start("image_view 64x64 cells + image_fill" *(n: 16))
+i = 0
+loop {
+	if ( gte(i: *(n: 16)) ) { stop }
+	cell = image_view(dest: rect_create(*(%(i: 4) 64) *(%(/(i: 4) 4) 64) +(*(%(i: 4) 64) 64) +(*(%(/(i: 4) 4) 64) 64)))
+	image_fill(cell: fill_color:)
+	++(i:)
+}
+bench_stop()
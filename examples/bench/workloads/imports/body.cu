@@ -0,0 +1,3 @@
+elem = gui_new_empty()
+gui_text(elem: "imported")
+gui_visible(elem: false)
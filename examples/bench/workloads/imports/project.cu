@@ -0,0 +1,4 @@
+import("body.cu")
+import("body.cu")
+import("body.cu")
+import("body.cu")
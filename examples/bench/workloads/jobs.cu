@@ -0,0 +1,54 @@
+# Tiled image jobs on the thread pool #
+
+w = 3840
+h = 2160
+n = 10
+frame = image_create(w: h: "A8R8G8B8")
+top = [ red = 20 green = 40 blue = 120 alpha = 255 ]
+bottom = [ red = 240 green = 160 blue = 40 alpha = 255 ]
+
+bench_start("image_fill 3840x2160 (single thread)" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_fill(frame: top:)
+	++(i:)
+}
+bench_stop()
+
+bench_start("image_run fill 3840x2160" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_run("fill" frame: top:)
+	++(i:)
+}
+bench_stop()
+
+bench_start("image_run gradient 3840x2160" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_run("gradient" frame: top: bottom: true)
+	++(i:)
+}
+bench_stop()
+
+bench_start("image_run resample 3840x2160 to 1280x720" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_run("resample" frame: 1280 720)
+	++(i:)
+}
+bench_stop()
+
+bench_start("image_job + job_wait gradient 3840x2160" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	job = image_job("gradient" frame: top: bottom:)
+	job_wait(job:)
+	++(i:)
+}
+bench_stop()
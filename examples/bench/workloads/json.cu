@@ -0,0 +1,31 @@
+# Building, writing and parsing JSON #
+
+n = 1000
+item = [ name = "bench" value = 10 enabled = true ]
+
+js = json()
+json_init_root(js:)
+root = json_root(js:)
+
+bench_start("json build" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	json_element_attrs( json_add_child(root: "item") item: )
+	++(i:)
+}
+bench_stop()
+
+bench_start("json write" 1)
+json_save(js: "bench_out.json")
+bench_stop()
+
+m = 20
+bench_start("json parse, 1000 nodes" m:)
+i = 0
+loop {
+	if ( gte(i: m:) ) { stop }
+	json_load(json() "bench_out.json")
+	++(i:)
+}
+bench_stop()
@@ -0,0 +1,84 @@
+# Filling an image one pixel at a time #
+
+w = 128
+h = 128
+img = image_create(w: h: "A8R8G8B8")
+color = [ red = 200 green = 100 blue = 50 alpha = 255 ]
+
+bench_start("set_pixel fill 128x128" *(w: h:))
+y = 0
+loop {
+	if ( gte(y: h:) ) { stop }
+	x = 0
+	loop {
+		if ( gte(x: w:) ) { stop }
+		set_pixel(img: x: y: color:)
+		++(x:)
+	}
+	++(y:)
+}
+bench_stop()
+
+bench_start("get_pixel 128x128" *(w: h:))
+y = 0
+loop {
+	if ( gte(y: h:) ) { stop }
+	x = 0
+	loop {
+		if ( gte(x: w:) ) { stop }
+		get_pixel(img: x: y:)
+		++(x:)
+	}
+	++(y:)
+}
+bench_stop()
+
+bench_start("get_pixel 128x128, storage" *(w: h:))
+y = 0
+loop {
+	if ( gte(y: h:) ) { stop }
+	x = 0
+	loop {
+		if ( gte(x: w:) ) { stop }
+		get_pixel(img: x: y: color:)
+		++(x:)
+	}
+	++(y:)
+}
+bench_stop()
+
+row = pixels_create(w:)
+i = 0
+loop {
+	if ( gte(i: w:) ) { stop }
+	pixels_set(row: i: 200 100 50 255)
+	++(i:)
+}
+
+bench_start("image_set_row fill 128x128" *(w: h:))
+y = 0
+loop {
+	if ( gte(y: h:) ) { stop }
+	image_set_row(img: y: row:)
+	++(y:)
+}
+bench_stop()
+
+bench_start("image_get_row 128x128, storage" *(w: h:))
+y = 0
+loop {
+	if ( gte(y: h:) ) { stop }
+	image_get_row(img: y: row:)
+	++(y:)
+}
+bench_stop()
+
+n = 100
+bench_start("image_fill_rect 128x128" *(n: w: h:))
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	image_fill_rect(img: 0 0 w: h: color:)
+	++(i:)
+}
+bench_stop()
@@ -0,0 +1,42 @@
+# Simple getters and setters #
+
+n = 100000
+elem = gui_create("staticText")
+
+bench_start("gui_visible toggle" n:)
+i = 0
+on = true
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_visible(elem: on:)
+	on = not(on:)
+	++(i:)
+}
+bench_stop()
+
+bench_start("gui_visible get" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_visible(elem:)
+	++(i:)
+}
+bench_stop()
+
+bench_start("gui_text set" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_text(elem: "Some text")
+	++(i:)
+}
+bench_stop()
+
+bench_start("gui_text get" n:)
+i = 0
+loop {
+	if ( gte(i: n:) ) { stop }
+	gui_text(elem:)
+	++(i:)
+}
+bench_stop()
@@ -114,7 +114,7 @@ int main() {
 
 	std::printf("post construct cfistream\n");
 
-	cubr::CuBridge  cubridge = cubr::CuBridge(cuengine, device->getGUIEnvironment(), nullptr);
+	cubr::CuBridge  cubridge(cuengine, device->getGUIEnvironment(), nullptr);
 
 	std::printf("post construct cubridge\n");
 
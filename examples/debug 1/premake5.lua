@@ -34,7 +34,8 @@ project "Debug CuBridge"
 		"Xxf86vm",
 		"Xext",
 		"X11",
-		"Xcursor"
+		"Xcursor",
+		"pthread"
 	}
 	defines( "SYSTEM=Linux" )
 	files {
@@ -123,7 +123,7 @@ int main() {
 
 	std::printf("post construct cfistream, logger, engine, and event handler\n");
 
-	cubr::CuBridge  cubridge = cubr::CuBridge(cuengine, device->getGUIEnvironment(), nullptr);
+	cubr::CuBridge  cubridge(cuengine, device->getGUIEnvironment(), nullptr);
 
 	std::printf("post construct cubridge\n");
 
@@ -142,7 +142,7 @@ int main() {
 	cubr::EventHandler ceh(cuengine);
 	device->setEventReceiver(&ceh);
 
-	cubr::CuBridge  cubridge = cubr::CuBridge(cuengine, device->getGUIEnvironment(), nullptr);
+	cubr::CuBridge  cubridge(cuengine, device->getGUIEnvironment(), nullptr);
 
 	AppCuInterface  aci(cuengine, device);
 
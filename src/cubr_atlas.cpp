@@ -0,0 +1,324 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_atlas.h"
+#include "cubr_messagecodes.h"
+#include "cubr_geom.h"
+#include "cubr_pixfmt.h"
+#include <cstdio>
+#include <cstring>
+
+namespace cubr {
+
+using irr::s32;
+using irr::u32;
+
+//----- SkylinePacker
+
+SkylinePacker::SkylinePacker( const irr::core::dimension2du&  s )
+	: skyline()
+	, size(s)
+{
+	Node  first = { 0, 0, (s32)s.Width };
+	skyline.push_back(first);
+}
+
+bool
+SkylinePacker::insert( u32  width, u32  height, irr::core::vector2di&  position ) {
+	const s32  w = (s32)width;
+	const s32  h = (s32)height;
+	s32  bestY = 0;
+	s32  bestWidth = 0;
+	s32  best = -1;
+	s32  y;
+	u32  i = 0;
+
+	if ( width == 0 || height == 0 )
+		return false;
+
+	// Lowest top edge wins. Ties go to the narrowest node, leaving wide gaps for wide rectangles.
+	for (; i < skyline.size(); ++i) {
+		y = fit(i, w, h);
+		if ( y < 0 )
+			continue;
+		if ( best < 0 || y + h < bestY || ( y + h == bestY && skyline[i].width < bestWidth ) ) {
+			bestY = y + h;
+			bestWidth = skyline[i].width;
+			best = (s32)i;
+			position.set( skyline[i].x, y );
+		}
+	}
+	if ( best < 0 )
+		return false;
+
+	Node  added = { position.X, position.Y + h, w };
+	skyline.insert(added, (u32)best);
+
+	// Nodes under the new one are shortened or removed
+	for (i = (u32)best + 1; i < skyline.size(); ) {
+		const s32  overlap = added.x + added.width - skyline[i].x;
+		if ( overlap <= 0 )
+			break;
+		skyline[i].x += overlap;
+		skyline[i].width -= overlap;
+		if ( skyline[i].width > 0 )
+			break;
+		skyline.erase(i);
+	}
+	merge();
+	return true;
+}
+
+const irr::core::dimension2du&
+SkylinePacker::getSize() const {
+	return size;
+}
+
+s32
+SkylinePacker::fit( u32  index, s32  width, s32  height ) const {
+	const s32  x = skyline[index].x;
+	s32  y = 0;
+	s32  remaining = width;
+
+	if ( x + width > (s32)size.Width )
+		return -1;
+
+	for (; remaining > 0; ++index) {
+		// The width check above guarantees the nodes cover the rectangle
+		if ( skyline[index].y > y )
+			y = skyline[index].y;
+		if ( y + height > (s32)size.Height )
+			return -1;
+		remaining -= skyline[index].width;
+	}
+	return y;
+}
+
+void
+SkylinePacker::merge() {
+	u32  i = 1;
+	while ( i < skyline.size() ) {
+		if ( skyline[i-1].y == skyline[i].y ) {
+			skyline[i-1].width += skyline[i].width;
+			skyline.erase(i);
+		} else {
+			++i;
+		}
+	}
+}
+
+//----- Atlas
+
+bool isAtlasObject( Cu::Object&  object ) {
+	return object.getType() == Atlas::getTypeAsCuType();
+}
+
+Atlas::Atlas( video_driver_t*  driver, TextureManager&  manager, const irr::core::dimension2du&  size )
+	: Cu::Object( Atlas::getTypeAsCuType() )
+	, packer(size)
+	, pixels()
+	, texture()
+	, videoDriver(driver)
+	, textureManager(&manager)
+	, files()
+	, changed(true)
+{
+	videoDriver->grab();
+	textureManager->grab();
+	image_t*  img = driver->createImage( irr::video::ECF_A8R8G8B8, size );
+	img->fill( irr::video::SColor(0,0,0,0) );
+	pixels.set(img);
+	img->drop();
+}
+
+Atlas::~Atlas() {
+	// GUI elements using the texture keep it alive, but the driver no longer needs to hold it.
+	if ( texture )
+		textureManager->remove( texture.get() );
+	// Released before the driver, which may be the last thing holding it
+	texture.set(0);
+	pixels.set(0);
+	textureManager->drop();
+	videoDriver->drop();
+}
+
+bool
+Atlas::add( image_t*  img, const rect_t&  area, rect_t&  placed ) {
+	irr::core::vector2di  position;
+	if ( ! packer.insert( (u32)area.getWidth() + PADDING, (u32)area.getHeight() + PADDING, position ) )
+		return false;
+
+	img->copyTo( pixels.get(), position, area );
+	placed = rect_t( position, area.getSize() );
+	changed = true;
+	return true;
+}
+
+bool
+Atlas::addFile( const util::String&  path, image_t*  img, rect_t&  placed ) {
+	if ( ! add( img, rect_t( irr::core::vector2di(0,0), img->getDimension() ), placed ) )
+		return false;
+	files.insert( path.c_str(), placed );
+	return true;
+}
+
+const rect_t*
+Atlas::findFile( const util::String&  path ) const {
+	return files.find( path.c_str() );
+}
+
+texture_t*
+Atlas::commit() {
+	if ( ! changed )
+		return texture.get();
+	changed = false;
+
+	const irr::core::dimension2du  size = pixels.access().getDimension();
+	if ( texture ) {
+		// Updating in place keeps the texture valid for the GUI elements already using it
+		texture_t&  tex = texture.access();
+		const irr::video::ECOLOR_FORMAT  format = tex.getColorFormat();
+		irr::u8*  d = 0;
+		if ( tex.getSize() == size && isPackableColorFormat(format) )
+			d = (irr::u8*)tex.lock( irr::video::ETLM_WRITE_ONLY );
+		if ( d ) {
+			const irr::u8*  s = (const irr::u8*)pixels.access().lock();
+			const u32  bytesPerRow = size.Width * 4;
+			u32  y = 0;
+			for (; y < size.Height; ++y) {
+				if ( format == irr::video::ECF_A8R8G8B8 )
+					std::memcpy( d, s, bytesPerRow );
+				else
+					writePixelsARGB( (const u32*)s, format, d, size.Width );
+				s += pixels.access().getPitch();
+				d += tex.getPitch();
+			}
+			pixels.access().unlock();
+			tex.unlock();
+			if ( tex.hasMipMaps() )
+				tex.regenerateMipMapLevels();
+			return texture.get();
+		}
+		// The driver changed the texture (such as scaling it to a power of two), so it is replaced
+		textureManager->remove( texture.get() );
+		texture.set(0);
+	}
+
+	char  name[48];
+	std::snprintf(name, 48, "cubr_atlas_%p", (void*)this);
+	texture.set( videoDriver->addTexture( name, pixels.get() ) );
+	if ( texture )
+		textureManager->add( name, texture.get() );
+	return texture.get();
+}
+
+texture_t*
+Atlas::getTexture() {
+	return commit();
+}
+
+Cu::Object*
+Atlas::copy() {
+	// Sprites refer to the atlas, so it is shared rather than copied
+	this->ref();
+	return this;
+}
+
+void
+Atlas::writeToString(String& out) const {
+	char  buffer[50];
+	const irr::core::dimension2du&  size = packer.getSize();
+	std::snprintf(buffer, 50, "{CuBridge Atlas %ux%u}", size.Width, size.Height);
+	out = buffer;
+}
+
+const char*
+Atlas::typeName() const {
+	return Atlas::StaticTypeName();
+}
+
+bool
+Atlas::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == Atlas::getTypeAsCuType();
+}
+
+//----- Sprite
+
+bool isSpriteObject( Cu::Object&  object ) {
+	return object.getType() == Sprite::getTypeAsCuType();
+}
+
+Sprite::Sprite( Atlas&  a, const rect_t&  r )
+	: Cu::Object( Sprite::getTypeAsCuType() )
+	, atlas(&a)
+	, rect(r)
+{
+	atlas->ref();
+}
+
+Sprite::~Sprite() {
+	atlas->deref();
+}
+
+Atlas&
+Sprite::getAtlas() {
+	return *atlas;
+}
+
+const rect_t&
+Sprite::getRect() const {
+	return rect;
+}
+
+texture_t*
+Sprite::getTexture() {
+	return atlas->getTexture();
+}
+
+Cu::Object*
+Sprite::copy() {
+	return new Sprite(*atlas, rect);
+}
+
+void
+Sprite::writeToString(String& out) const {
+	char  buffer[80];
+	std::snprintf(buffer, 80, "{CuBridge Sprite %d,%d %dx%d}",
+		rect.UpperLeftCorner.X, rect.UpperLeftCorner.Y, rect.getWidth(), rect.getHeight());
+	out = buffer;
+}
+
+const char*
+Sprite::typeName() const {
+	return Sprite::StaticTypeName();
+}
+
+bool
+Sprite::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == Sprite::getTypeAsCuType();
+}
+
+//----- Foreign functions
+
+Cu::ForeignFunc::Result
+CommitAtlas( Cu::FFIServices&  ffi, Atlas&  atlas ) {
+	texture_t*  tex = atlas.commit();
+	if ( tex )
+		ffi.setNewResult( new Texture(tex) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+GetSpriteRect( Cu::FFIServices&  ffi, Sprite&  sprite ) {
+	ffi.setNewResult( new Rect( sprite.getRect() ) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+GetSpriteTexture( Cu::FFIServices&  ffi, Sprite&  sprite ) {
+	texture_t*  tex = sprite.getTexture();
+	if ( tex )
+		ffi.setNewResult( new Texture(tex) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+}
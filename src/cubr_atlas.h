@@ -0,0 +1,197 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_ATLAS_H_
+#define _CUBR_ATLAS_H_
+
+#include <Copper.h>
+#include <irrArray.h> // from Irrlicht
+#include "cubr_base.h"
+#include "cubr_strmap.h"
+#include "cubr_texmgr.h"
+
+namespace cubr {
+
+//! Skyline Packer
+/*
+	Places rectangles bottom-left first, keeping only the top edge (the "skyline") of the rectangles
+	placed so far. It is fast and packs the handful of similar images in a GUI atlas well.
+*/
+class SkylinePacker {
+	struct Node {
+		irr::s32  x;
+		irr::s32  y;
+		irr::s32  width;
+	};
+
+	irr::core::array<Node>  skyline;
+	irr::core::dimension2du  size;
+
+public:
+	SkylinePacker( const irr::core::dimension2du& );
+
+	//! Finds room for a rectangle of the given size. Returns false if there is none.
+	bool
+	insert( irr::u32  width, irr::u32  height, irr::core::vector2di&  position );
+
+	const irr::core::dimension2du&
+	getSize() const;
+
+private:
+	//! Returns the lowest y at which the rectangle fits with its left edge at the node, or -1.
+	irr::s32
+	fit( irr::u32  index, irr::s32  width, irr::s32  height ) const;
+
+	void
+	merge();
+};
+
+bool
+isAtlasObject( Cu::Object& );
+
+bool
+isSpriteObject( Cu::Object& );
+
+//! Texture Atlas
+/*
+	Packs many small images into one texture so that drawing them needs fewer texture switches
+	and the video driver holds fewer textures.
+	Images are copied into an A8R8G8B8 image as they are added. commit() copies that into the texture,
+	which is created the first time and updated in place afterwards.
+	The texture is added to the texture manager, so it counts against the texture budget, and is removed
+	when the atlas is destroyed. The atlas holds the texture manager and the video driver until then.
+*/
+class Atlas : public Cu::Object {
+public:
+	// Space left between images so that filtering does not bleed one into another
+	enum { PADDING = 1 };
+
+private:
+	SkylinePacker  packer;
+	irrptr<image_t>  pixels;
+	irrptr<texture_t>  texture;
+	video_driver_t*  videoDriver;
+	TextureManager*  textureManager;
+	StringMap<rect_t>  files;
+	bool  changed;
+
+public:
+	Atlas( video_driver_t*, TextureManager&, const irr::core::dimension2du& );
+
+	~Atlas();
+
+	//! Copies the area of the image into the atlas. Placed receives where it was put.
+	//! Returns false if there is no room.
+	bool
+	add( image_t*, const rect_t&  area, rect_t&  placed );
+
+	//! Same as add() for the whole image, but remembers the file it was loaded from (see findFile()).
+	bool
+	addFile( const util::String&  path, image_t*, rect_t&  placed );
+
+	//! Returns where the image of the given file was put or null if it has not been added.
+	const rect_t*
+	findFile( const util::String&  path ) const;
+
+	//! Creates or updates the texture with the images added so far.
+	texture_t*
+	commit();
+
+	//! Returns the texture, committing first if images were added since the last commit.
+	texture_t*
+	getTexture();
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubratlas";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::Atlas );
+	}
+};
+
+//! Sprite
+/*
+	An image in an atlas.
+	AttributeSource turns a sprite into a texture (the atlas texture) and, for the matching rectangle
+	attribute (such as "ImageRect" for "Image"), into the rectangle of the sprite.
+*/
+class Sprite : public Cu::Object {
+	Atlas*  atlas;
+	rect_t  rect;
+
+public:
+	Sprite( Atlas&, const rect_t& );
+
+	~Sprite();
+
+	Atlas&
+	getAtlas();
+
+	const rect_t&
+	getRect() const;
+
+	//! Same as Atlas::getTexture()
+	texture_t*
+	getTexture();
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubrsprite";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::Sprite );
+	}
+};
+
+// atlas_commit( atlas )
+// Updates the atlas texture with the images added so far and returns it.
+Cu::ForeignFunc::Result
+CommitAtlas( Cu::FFIServices&, Atlas& );
+
+// sprite_rect( sprite )
+// Returns the area of the atlas texture covered by the sprite as a cubrrect.
+Cu::ForeignFunc::Result
+GetSpriteRect( Cu::FFIServices&, Sprite& );
+
+// sprite_texture( sprite )
+// Returns the atlas texture, committing the atlas first if it has changed.
+Cu::ForeignFunc::Result
+GetSpriteTexture( Cu::FFIServices&, Sprite& );
+
+}
+
+#endif
@@ -3,9 +3,65 @@
 #include "cubr_attr.h"
 #include "cubr_base.h"
 #include "cubr_str.h"
+#include "cubr_geom.h"
+#include "cubr_atlas.h"
+#include "cubr_imgload.h"
+#include <cstring>
 
 namespace cubr {
 
+namespace {
+
+//! Attribute Name Table
+/*
+	Every attribute name searched for by an AttributeSource, each with the Copper string used to search
+	the scope. Only names asked for by Irrlicht and cubr are added, never those of the script's members.
+	Irrlicht elements use a small, fixed set of attribute names, so the table stays small and
+	the strings are made once for the whole program rather than once per attribute per element.
+*/
+struct AttributeNameTable {
+	StringMap<u32>  ids;
+	core::array<Cu::String>  names;
+
+	AttributeNameTable()
+		: ids(256)
+		, names()
+	{
+		names.reallocate(128);
+	}
+};
+
+AttributeNameTable&
+getAttributeNameTable() {
+	static AttributeNameTable  table;
+	return table;
+}
+
+u32
+getAttributeNameId( const c8*  name ) {
+	AttributeNameTable&  table = getAttributeNameTable();
+	const u32*  id = table.ids.find(name);
+	if ( id )
+		return *id;
+	table.names.push_back( Cu::String(name) );
+	return table.ids.insert(name, table.names.size() - 1);
+}
+
+//! Returns the ID of the name or -1 if it is not in the table. Never adds the name.
+s32
+findAttributeNameId( const c8*  name ) {
+	const u32*  id = getAttributeNameTable().ids.find(name);
+	return id ? (s32)*id : -1;
+}
+
+//! Only valid until the next new name is added
+const Cu::String&
+getInternedName( u32  id ) {
+	return getAttributeNameTable().names[id];
+}
+
+}
+
 bool getBoolValue( Cu::Object* obj, bool defaultValue ) {
 	if ( obj ) {
 		if ( Cu::isBoolObject(*obj) )
@@ -38,31 +94,195 @@ f32 getF32Value( Cu::Object* obj, f32 defaultValue ) {
 	return defaultValue;
 }
 
-AttributeSource::AttributeSource( video_driver_t*  vidDriver, Cu::FunctionObject& src )
+// Returns the result of the given member function or null if it has none
+static Cu::Object* getResultObject( Cu::FunctionObject* member ) {
+	Cu::Function*  f;
+	Cu::Object*  object;
+	if ( member->getFunction(f) ) {
+		if ( f->result.obtain(object) )
+			return object;
+	}
+	return 0;
+}
+
+// Returns the values of the float array stored in the given member if it has at least the given number of values
+static const f32* getFloatArrayValues( Cu::FunctionObject* member, u32 size ) {
+	Cu::Object*  object = getResultObject(member);
+	if ( object && isFloatArrayObject(*object) ) {
+		if ( ((FloatArray*)object)->size() >= size )
+			return ((FloatArray*)object)->data();
+	}
+	return 0;
+}
+
+AttributeSource::AttributeSource( video_driver_t*  vidDriver, Cu::FunctionObject& src, bool  useNativeGeometry )
 	: videoDriver(vidDriver)
 	, infoSource(src)
 	, infoNamesList()
+	, infoNamesListed(false)
+	, memberIndexCount(0)
+	, memberIndexComplete(false)
+	, memberIndexStale(false)
+	, projection(8)
+	, projecting(false)
+	, nativeGeometry(useNativeGeometry)
 {
+	resetMemberIndex();
+}
+
+void
+AttributeSource::project(const c8* attributeName) {
+	projection.insert(attributeName, true);
+	projecting = true;
+}
+
+void
+AttributeSource::resetMemberIndex() const {
+	u32  i = 0;
+
+	infoNamesList.clear();
+	infoNamesListed = false;
+	for (; i < MEMBER_INDEX_SIZE; ++i)
+		memberIndex[i].nameId = -1;
+	memberIndexCount = 0;
+	memberIndexComplete = false;
+	memberIndexStale = false;
+}
+
+const AttributeSource::slist_t&
+AttributeSource::getNamesList() const {
+	Cu::Function*  f;
+
+	if ( memberIndexStale )
+		resetMemberIndex();
+
+	if ( ! infoNamesListed ) {
+		infoNamesListed = true;
+		if ( infoSource.getFunction(f) ) {
+			// append() fills both the names list and the index, clearing this for names it cannot index
+			memberIndexComplete = true;
+			f->getPersistentScope().appendNamesByInterface( const_cast<AttributeSource*>(this) );
+		}
+	}
+	return infoNamesList;
+}
+
+AttributeSource::MemberSlot*
+AttributeSource::getMemberSlot(u32 nameId, bool create) const {
+	const u32  mask = MEMBER_INDEX_SIZE - 1;
+	u32  i = (nameId * 2654435761u >> 16) & mask;
+
+	// The index is never more than MEMBER_INDEX_MAX full, so there is always an empty slot to stop at
+	for (; memberIndex[i].nameId >= 0; i = (i + 1) & mask) {
+		if ( memberIndex[i].nameId == (s32)nameId )
+			return &(memberIndex[i]);
+	}
+	if ( ! create || memberIndexCount >= MEMBER_INDEX_MAX )
+		return 0;
+
+	++memberIndexCount;
+	memberIndex[i].nameId = (s32)nameId;
+	memberIndex[i].listIndex = -1;
+	memberIndex[i].variable = 0;
+	return &(memberIndex[i]);
+}
+
+Cu::Variable*
+AttributeSource::findMemberVariable(const c8* attributeName) const {
+	const u32  nameId = getAttributeNameId(attributeName);
+	Cu::Variable*  v = 0;
+	Cu::Function*  f;
+	MemberSlot*  slot;
+
+	if ( memberIndexStale )
+		resetMemberIndex();
+
+	slot = getMemberSlot(nameId, false);
+	if ( slot )
+		return slot->variable;
+	if ( memberIndexComplete )
+		return 0;
+
+	// First search for this name
+	if ( infoSource.getFunction(f) ) {
+		if ( ! f->getPersistentScope().findVariable(getInternedName(nameId), v) ) {
+			v = 0;
+		}
+	}
+	slot = getMemberSlot(nameId, true);
+	if ( slot )
+		slot->variable = v;
+	return v;
+}
+
+Cu::FunctionObject*
+AttributeSource::findMemberByName(const c8* attributeName) const {
+	Cu::Variable*  v = findMemberVariable(attributeName);
+	if ( v )
+		return v->getRawContainer();
+	return 0;
+}
+
+Cu::Variable*
+AttributeSource::obtainMemberVariable(const c8* attributeName) const {
+	Cu::Variable*  v;
 	Cu::Function*  f;
+	u32  nameId;
+
+	if ( projecting && ! projection.find(attributeName) )
+		return 0;
+
+	nameId = getAttributeNameId(attributeName);
+
+	// A stale index is only rebuilt for reading. Serializing creates one member after another, and
+	// rebuilding between each of them would be wasteful.
+	if ( ! memberIndexStale ) {
+		MemberSlot*  slot = getMemberSlot(nameId, false);
+		if ( slot && slot->variable )
+			return slot->variable;
+	}
 
 	if ( infoSource.getFunction(f) ) {
-		f->getPersistentScope().appendNamesByInterface(this);
+		// Creates the variable. Adding to the scope may move the other variables, so the index is rebuilt
+		// the next time it is needed.
+		f->getPersistentScope().getVariable(getInternedName(nameId), v);
+		memberIndexStale = true;
+		return v;
+	}
+	return 0;
+}
+
+void
+AttributeSource::setFloatArrayMember(const c8* attributeName, const f32* values, u32 size) {
+	Cu::Variable*  v = obtainMemberVariable(attributeName);
+	FloatArray*  r;
+
+	if ( v ) {
+		r = new FloatArray(size, values);
+		v->setFuncReturn(r, false);
+		r->deref();
 	}
 }
 
 Cu::FunctionObject*
 AttributeSource::getMemberByName(const c8* attributeName) const {
-	return getSubMemberByName(infoSource, attributeName);
+	Cu::Variable*  v = obtainMemberVariable(attributeName);
+	if ( v )
+		return v->getRawContainer();
+	return 0;
 }
 
 Cu::FunctionObject*
 AttributeSource::getSubMemberByName(Cu::FunctionObject& container, const c8* attributeName) const {
 	Cu::Function*  f;
-	const Cu::String  name(attributeName);
 	Cu::Variable* v;
 
+	if ( &container == &infoSource ) {
+		return getMemberByName(attributeName);
+	}
+
 	if ( container.getFunction(f) ) {
-		f->getPersistentScope().getVariable(name, v);
+		f->getPersistentScope().getVariable(getInternedName( getAttributeNameId(attributeName) ), v);
 		return v->getRawContainer();
 	}
 	return 0; // Irrlicht uses 0 instead of nullptr
@@ -70,11 +290,26 @@ AttributeSource::getSubMemberByName(Cu::FunctionObject& container, const c8* att
 
 Cu::Object*
 AttributeSource::getMemberFunctionResult(const c8* attributeName) const {
-	return getSubMemberFunctionResult(infoSource, attributeName);
+	Cu::FunctionObject*  member = findMemberByName(attributeName);
+	Cu::Function*  func;
+	Cu::Object*  object;
+
+	if ( member ) {
+		if ( member->getFunction(func) ) {
+			if ( func->result.obtain(object) ) {
+				return object;
+			}
+		}
+	}
+	return 0; // Irrlicht uses 0 instead of nullptr
 }
 
 Cu::Object*
 AttributeSource::getSubMemberFunctionResult(Cu::FunctionObject& container, const c8* attributeName) const {
+	if ( &container == &infoSource ) {
+		return getMemberFunctionResult(attributeName);
+	}
+
 	Cu::FunctionObject*  member = getSubMemberByName(container, attributeName);
 	Cu::Function*  func;
 	Cu::Object*  object;
@@ -109,12 +344,17 @@ AttributeSource::getAttributeAsFloat(Cu::FunctionObject& source, const c8* attri
 
 core::vector2df
 AttributeSource::getAttributeAsVector2d(Cu::FunctionObject& source, const c8* attributeName, core::vector2df defaultNotFound) const {
-	// Get values from members labeled "x", "y", and "z".
-	Cu::FunctionObject*  wrapperMember = getSubMemberByName(source, attributeName);
+	// Get values from members labeled "x" and "y".
+	Cu::FunctionObject*  wrapperMember =
+		( &source == &infoSource ) ? findMemberByName(attributeName) : getSubMemberByName(source, attributeName);
 	Cu::Object*  object;
 	core::vector2df  out(defaultNotFound);
 
 	if ( wrapperMember ) {
+		object = getResultObject(wrapperMember);
+		if ( object && isVector2Object(*object) )
+			return ((Vector2*)object)->get();
+
 		object = getSubMemberFunctionResult(*wrapperMember, "x");
 		out.X = getF32Value(object, defaultNotFound.X);
 
@@ -128,7 +368,8 @@ AttributeSource::getAttributeAsVector2d(Cu::FunctionObject& source, const c8* at
 core::vector3df
 AttributeSource::getAttributeAsVector3d(Cu::FunctionObject& source, const c8* attributeName, core::vector3df defaultNotFound) const {
 	// Get values from members labeled "x", "y", and "z".
-	Cu::FunctionObject*  wrapperMember = getSubMemberByName(source, attributeName);
+	Cu::FunctionObject*  wrapperMember =
+		( &source == &infoSource ) ? findMemberByName(attributeName) : getSubMemberByName(source, attributeName);
 	Cu::Object*  object;
 	core::vector3df  out(0);
 
@@ -208,17 +449,32 @@ AttributeSource::setSubMemberFunctionResult(Cu::FunctionObject& source, const c8
 void
 AttributeSource::append( Cu::Object* object ) {
 	const util::String  s = ((Cu::StringObject*)object)->getString();
+	// Names Irrlicht has never asked for are not added to the name table, so scripts cannot grow it
+	const s32  nameId = findAttributeNameId(s.c_str());
+	MemberSlot*  slot = nameId >= 0 ? getMemberSlot((u32)nameId, true) : 0;
+	Cu::Function*  f;
+	Cu::Variable*  v;
+
 	infoNamesList.push_back(s);
+	if ( ! slot ) {
+		memberIndexComplete = false;
+		return;
+	}
+	if ( infoSource.getFunction(f) ) {
+		f->getPersistentScope().getVariable(s, v); // Already exists, so nothing is created
+		slot->variable = v;
+		slot->listIndex = (s32)infoNamesList.size() - 1;
+	}
 }
 
 u32
 AttributeSource::getAttributeCount() const {
-	return (u32)(infoNamesList.size());
+	return (u32)(getNamesList().size());
 }
 
 const c8*
 AttributeSource::getAttributeName(s32 index) const {
-	return infoNamesList[index].c_str();
+	return getNamesList()[index].c_str();
 }
 
 io::E_ATTRIBUTE_TYPE
@@ -247,11 +503,21 @@ AttributeSource::getAttributeTypeString(s32 index, const wchar_t* defaultNotFoun
 
 bool
 AttributeSource::existsAttribute(const c8* attributeName) const {
-	return findAttribute(attributeName) != -1;
+	return findMemberVariable(attributeName) != 0;
 }
 
 s32 AttributeSource::findAttribute(const c8* attributeName) const {
-	slist_t::ConstIter  i = infoNamesList.constStart();
+	const u32  nameId = getAttributeNameId(attributeName);
+	const slist_t&  names = getNamesList();
+	const MemberSlot*  slot = getMemberSlot(nameId, false);
+
+	if ( slot && slot->listIndex >= 0 )
+		return slot->listIndex;
+	if ( memberIndexComplete )
+		return -1;
+
+	// Some members could not be indexed when listed
+	slist_t::ConstIter  i = names.constStart();
 	s32  idx = 0;
 	
 	if ( i.has() )
@@ -278,13 +544,10 @@ AttributeSource::addInt(const c8* attributeName, s32 value) {
 
 void
 AttributeSource::setAttribute(const c8* attributeName, s32 value) {
-	Cu::Function*  f;
-	const util::String  name(attributeName);
-	Cu::Variable*  v;
+	Cu::Variable*  v = obtainMemberVariable(attributeName);
 	Cu::IntegerObject*  r;
 
-	if ( infoSource.getFunction(f) ) {
-		f->getPersistentScope().getVariable(name, v);
+	if ( v ) {
 		r = new Cu::IntegerObject(value);
 		v->setFuncReturn(r, false);
 		r->deref();
@@ -299,12 +562,12 @@ AttributeSource::getAttributeAsInt(const c8* attributeName, irr::s32 defaultNotF
 
 s32
 AttributeSource::getAttributeAsInt(s32 index) const {
-	return getAttributeAsInt(infoNamesList[index].c_str(), 0);
+	return getAttributeAsInt(getNamesList()[index].c_str(), 0);
 }
 
 void
 AttributeSource::setAttribute(s32 index, s32 value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -315,13 +578,10 @@ AttributeSource::addFloat(const c8* attributeName, f32 value) {
 
 void
 AttributeSource::setAttribute(const c8* attributeName, f32 value) {
-	Cu::Function*  f;
-	const util::String  name(attributeName);
-	Cu::Variable*  v;
+	Cu::Variable*  v = obtainMemberVariable(attributeName);
 	Cu::DecimalNumObject*  r;
 
-	if ( infoSource.getFunction(f) ) {
-		f->getPersistentScope().getVariable(name, v);
+	if ( v ) {
 		r = new Cu::DecimalNumObject(value);
 		v->setFuncReturn(r, false);
 		r->deref();
@@ -336,12 +596,12 @@ AttributeSource::getAttributeAsFloat(const c8* attributeName, irr::f32 defaultNo
 
 f32
 AttributeSource::getAttributeAsFloat(s32 index) const {
-	return getAttributeAsFloat(infoNamesList[index].c_str(), 0.f);
+	return getAttributeAsFloat(getNamesList()[index].c_str(), 0.f);
 }
 
 void
 AttributeSource::setAttribute(s32 index, f32 value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -352,13 +612,10 @@ AttributeSource::addString(const c8* attributeName, const c8* value) {
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const c8* value) {
-	Cu::Function*  f;
-	const util::String  name(attributeName);
-	Cu::Variable*  v;
+	Cu::Variable*  v = obtainMemberVariable(attributeName);
 	Cu::StringObject*  r;
 
-	if ( infoSource.getFunction(f) ) {
-		f->getPersistentScope().getVariable(name, v);
+	if ( v ) {
 		r = new Cu::StringObject(value);
 		v->setFuncReturn(r, false);
 		r->deref();
@@ -392,12 +649,12 @@ AttributeSource::getAttributeAsString(const c8* attributeName, c8* target) const
 
 core::stringc
 AttributeSource::getAttributeAsString(s32 index) const {
-	return getAttributeAsString(infoNamesList[index].c_str());
+	return getAttributeAsString(getNamesList()[index].c_str());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const c8* value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -408,13 +665,10 @@ AttributeSource::addString(const c8* attributeName, const wchar_t* value) {
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const wchar_t* value) {
-	Cu::Function*  f;
-	const util::String  name(attributeName);
-	Cu::Variable*  v;
+	Cu::Variable*  v = obtainMemberVariable(attributeName);
 	Cu::StringObject*  r;
 
-	if ( infoSource.getFunction(f) ) {
-		f->getPersistentScope().getVariable(name, v);
+	if ( v ) {
 		r = new Cu::StringObject( wcharToCuStr(value, wcstrlen(value)) );
 		v->setFuncReturn(r, false);
 		r->deref();
@@ -462,12 +716,12 @@ AttributeSource::getAttributeAsStringW(const c8* attributeName, wchar_t* target)
 
 core::stringw
 AttributeSource::getAttributeAsStringW(s32 index) const {
-	return getAttributeAsStringW(infoNamesList[index].c_str());
+	return getAttributeAsStringW(getNamesList()[index].c_str());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const wchar_t* value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -488,12 +742,12 @@ AttributeSource::getAttributeAsBinaryData(const c8* attributeName, void* outData
 
 void
 AttributeSource::getAttributeAsBinaryData(s32 index, void* outData, s32 maxSizeInBytes) const {
-	return getAttributeAsBinaryData(infoNamesList[index].c_str(), outData, maxSizeInBytes);
+	return getAttributeAsBinaryData(getNamesList()[index].c_str(), outData, maxSizeInBytes);
 }
 
 void
 AttributeSource::setAttribute(s32 index, void* data, s32 dataSizeInBytes ) {
-	setAttribute(infoNamesList[index].c_str(), data, dataSizeInBytes);
+	setAttribute(getNamesList()[index].c_str(), data, dataSizeInBytes);
 }
 
 void
@@ -516,12 +770,12 @@ AttributeSource::getAttributeAsArray(const c8* attributeName, const core::array<
 
 core::array<core::stringw>
 AttributeSource::getAttributeAsArray(s32 index) const {
-	return getAttributeAsArray(infoNamesList[index].c_str());
+	return getAttributeAsArray(getNamesList()[index].c_str());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::array<core::stringw>& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -532,13 +786,10 @@ AttributeSource::addBool(const c8* attributeName, bool value) {
 
 void
 AttributeSource::setAttribute(const c8* attributeName, bool value) {
-	Cu::Function*  f;
-	const util::String  name(attributeName);
-	Cu::Variable*  v;
+	Cu::Variable*  v = obtainMemberVariable(attributeName);
 	Cu::BoolObject*  r;
 
-	if ( infoSource.getFunction(f) ) {
-		f->getPersistentScope().getVariable(name, v);
+	if ( v ) {
 		r = new Cu::BoolObject(value);
 		v->setFuncReturn(r, false);
 		r->deref();
@@ -553,12 +804,12 @@ AttributeSource::getAttributeAsBool(const c8* attributeName, bool defaultNotFoun
 
 bool
 AttributeSource::getAttributeAsBool(s32 index) const {
-	return getAttributeAsBool(infoNamesList[index].c_str());
+	return getAttributeAsBool(getNamesList()[index].c_str());
 }
 
 void
 AttributeSource::setAttribute(s32 index, bool value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -575,13 +826,10 @@ AttributeSource::addEnum(const c8* attributeName, s32 enumValue, const c8* const
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const c8* enumValue, const c8* const* enumerationLiterals) {
-	Cu::Function*  f;
-	const util::String  name(attributeName);
-	Cu::Variable*  v;
+	Cu::Variable*  v = obtainMemberVariable(attributeName);
 	Cu::StringObject*  r;
 
-	if ( infoSource.getFunction(f) ) {
-		f->getPersistentScope().getVariable(name, v);
+	if ( v ) {
 		r = new Cu::StringObject(enumValue);
 		v->setFuncReturn(r, false);
 		r->deref();
@@ -622,12 +870,12 @@ AttributeSource::getAttributeAsEnumeration(const c8* attributeName, const c8* co
 
 s32
 AttributeSource::getAttributeAsEnumeration(s32 index, const c8* const* enumerationLiteralsToUse, s32 defaultNotFound) const {
-	return getAttributeAsEnumeration(infoNamesList[index].c_str(), enumerationLiteralsToUse, defaultNotFound);
+	return getAttributeAsEnumeration(getNamesList()[index].c_str(), enumerationLiteralsToUse, defaultNotFound);
 }
 
 const c8*
 AttributeSource::getAttributeAsEnumeration(s32 index) const {
-	return getAttributeAsEnumeration(infoNamesList[index].c_str());
+	return getAttributeAsEnumeration(getNamesList()[index].c_str());
 }
 
 void
@@ -637,12 +885,12 @@ AttributeSource::getAttributeEnumerationLiteralsOfEnumeration(const c8* attribut
 
 void
 AttributeSource::getAttributeEnumerationLiteralsOfEnumeration(s32 index, core::array<core::stringc>& outLiterals) const {
-	return getAttributeEnumerationLiteralsOfEnumeration(infoNamesList[index].c_str(), outLiterals);
+	return getAttributeEnumerationLiteralsOfEnumeration(getNamesList()[index].c_str(), outLiterals);
 }
 
 void
 AttributeSource::setAttribute(s32 index, const c8* enumValue, const c8* const* enumerationLiterals) {
-	setAttribute(infoNamesList[index].c_str(), enumValue, enumerationLiterals);
+	setAttribute(getNamesList()[index].c_str(), enumValue, enumerationLiterals);
 }
 
 void
@@ -664,7 +912,7 @@ void AttributeSource::setAttribute(const c8* attributeName, video::SColor value)
 
 video::SColor
 AttributeSource::getAttributeAsColor(const c8* attributeName, const video::SColor& defaultNotFound) const {
-	Cu::FunctionObject*  member = getMemberByName(attributeName);
+	Cu::FunctionObject*  member = findMemberByName(attributeName);
 	video::SColor  out = defaultNotFound;
 
 	if ( member ) {
@@ -678,12 +926,12 @@ AttributeSource::getAttributeAsColor(const c8* attributeName, const video::SColo
 
 video::SColor
 AttributeSource::getAttributeAsColor(s32 index) const {
-	return getAttributeAsColor(infoNamesList[index].c_str(), video::SColor(0));
+	return getAttributeAsColor(getNamesList()[index].c_str(), video::SColor(0));
 }
 
 void
 AttributeSource::setAttribute(s32 index, video::SColor value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -706,7 +954,7 @@ AttributeSource::setAttribute(const c8* attributeName, video::SColorf value) {
 
 video::SColorf
 AttributeSource::getAttributeAsColorf(const c8* attributeName, const video::SColorf& defaultNotFound) const {
-	Cu::FunctionObject*  member = getMemberByName(attributeName);
+	Cu::FunctionObject*  member = findMemberByName(attributeName);
 	video::SColorf  out = defaultNotFound;
 
 	if ( member ) {
@@ -720,12 +968,12 @@ AttributeSource::getAttributeAsColorf(const c8* attributeName, const video::SCol
 
 video::SColorf
 AttributeSource::getAttributeAsColorf(s32 index) const {
-	return getAttributeAsColorf(infoNamesList[index].c_str(), video::SColorf(0,0,0,0));
+	return getAttributeAsColorf(getNamesList()[index].c_str(), video::SColorf(0,0,0,0));
 }
 
 void
 AttributeSource::setAttribute(s32 index, video::SColorf value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -746,12 +994,12 @@ AttributeSource::getAttributeAsVector3d(const c8* attributeName, const core::vec
 
 core::vector3df
 AttributeSource::getAttributeAsVector3d(s32 index) const {
-	return getAttributeAsVector3d(infoNamesList[index].c_str(), core::vector3df(0,0,0));
+	return getAttributeAsVector3d(getNamesList()[index].c_str(), core::vector3df(0,0,0));
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::vector3df& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -762,12 +1010,17 @@ AttributeSource::addVector2d(const c8* attributeName, const core::vector2df& val
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::vector2df& value) {
-	// Break up into members labeled "x" and "y".
-	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
-
-	if ( wrapperMember ) {
-		setSubMemberFunctionResult(*wrapperMember, attributeName, value);
+	if ( nativeGeometry ) {
+		Cu::Variable*  v = obtainMemberVariable(attributeName);
+		if ( v ) {
+			Cu::Object*  r = new Vector2(value);
+			v->setFuncReturn(r, false);
+			r->deref();
+		}
+		return;
 	}
+	// Break up into members labeled "x" and "y".
+	setSubMemberFunctionResult(infoSource, attributeName, value);
 }
 
 core::vector2df
@@ -777,13 +1030,13 @@ AttributeSource::getAttributeAsVector2d(const c8* attributeName, const core::vec
 
 core::vector2df
 AttributeSource::getAttributeAsVector2d(s32 index) const {
-	return getAttributeAsVector2d(infoNamesList[index].c_str(), core::vector2df(0));
+	return getAttributeAsVector2d(getNamesList()[index].c_str(), core::vector2df(0));
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::vector2df& value) {
 	// Take advantage of auto-creation of object-function members in Copper
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -794,6 +1047,15 @@ AttributeSource::addPosition2d(const c8* attributeName, const core::position2di&
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::position2di& value) {
+	if ( nativeGeometry ) {
+		Cu::Variable*  v = obtainMemberVariable(attributeName);
+		if ( v ) {
+			Cu::Object*  r = new Vector2( core::vector2df((f32)value.X, (f32)value.Y) );
+			v->setFuncReturn(r, false);
+			r->deref();
+		}
+		return;
+	}
 	// Break up into members labeled "x" and "y".
 	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
 
@@ -806,11 +1068,17 @@ AttributeSource::setAttribute(const c8* attributeName, const core::position2di&
 core::position2di
 AttributeSource::getAttributeAsPosition2d(const c8* attributeName, const core::position2di& defaultNotFound) const {
 	// Get values from members labeled "x" and "y".
-	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
+	Cu::FunctionObject*  wrapperMember = findMemberByName(attributeName);
 	Cu::Object*  object;
 	core::position2di  out(defaultNotFound);
 
 	if ( wrapperMember ) {
+		object = getResultObject(wrapperMember);
+		if ( object && isVector2Object(*object) ) {
+			const core::vector2df&  v = ((Vector2*)object)->get();
+			return core::position2di( (s32)v.X, (s32)v.Y );
+		}
+
 		object = getSubMemberFunctionResult(*wrapperMember, "x");
 		out.X = getS32Value(object, defaultNotFound.X);
 
@@ -822,12 +1090,12 @@ AttributeSource::getAttributeAsPosition2d(const c8* attributeName, const core::p
 
 core::position2di
 AttributeSource::getAttributeAsPosition2d(s32 index) const {
-	return getAttributeAsPosition2d(infoNamesList[index].c_str(), core::position2di(0));
+	return getAttributeAsPosition2d(getNamesList()[index].c_str(), core::position2di(0));
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::position2di& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -838,6 +1106,15 @@ AttributeSource::addRect(const c8* attributeName, const core::rect<s32>& value)
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::rect<s32>& value) {
+	if ( nativeGeometry ) {
+		Cu::Variable*  v = obtainMemberVariable(attributeName);
+		if ( v ) {
+			Cu::Object*  r = new Rect(value);
+			v->setFuncReturn(r, false);
+			r->deref();
+		}
+		return;
+	}
 	// Break up into members labeled "x", "y", "x2", and "y2".
 	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
 
@@ -852,11 +1129,20 @@ AttributeSource::setAttribute(const c8* attributeName, const core::rect<s32>& va
 core::rect<s32>
 AttributeSource::getAttributeAsRect(const c8* attributeName, const core::rect<s32>& defaultNotFound) const {
 	// Get values from members labeled "x", "y", "x2", and "y2".
-	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
+	Cu::FunctionObject*  wrapperMember = findMemberByName(attributeName);
 	Cu::Object*  object;
 	core::rect<s32>  out(defaultNotFound);
 
+	// A sprite decides its own area, even over a rectangle left from the texture it replaced
+	Sprite*  sprite = findSpriteForRect(attributeName);
+	if ( sprite )
+		return sprite->getRect();
+
 	if ( wrapperMember ) {
+		object = getResultObject(wrapperMember);
+		if ( object && isRectObject(*object) )
+			return ((Rect*)object)->get();
+
 		object = getSubMemberFunctionResult(*wrapperMember, "x");
 		out.UpperLeftCorner.X = getS32Value(object, defaultNotFound.UpperLeftCorner.X);
 
@@ -872,14 +1158,36 @@ AttributeSource::getAttributeAsRect(const c8* attributeName, const core::rect<s3
 	return out;
 }
 
+Sprite*
+AttributeSource::findSpriteForRect(const c8* attributeName) const {
+	c8  imageName[64];
+	const size_t  length = std::strlen(attributeName);
+	Cu::Object*  object;
+
+	if ( length <= 4 || length - 4 >= 64 || std::strcmp(attributeName + length - 4, "Rect") != 0 )
+		return 0;
+
+	// IGUIImage pairs "SourceRect" with "Texture"
+	if ( std::strcmp(attributeName, "SourceRect") == 0 ) {
+		object = getMemberFunctionResult("Texture");
+	} else {
+		std::memcpy(imageName, attributeName, length - 4);
+		imageName[length - 4] = 0;
+		object = getMemberFunctionResult(imageName);
+	}
+	if ( object && isSpriteObject(*object) )
+		return (Sprite*)object;
+	return 0;
+}
+
 core::rect<s32>
 AttributeSource::getAttributeAsRect(s32 index) const {
-	return getAttributeAsRect(infoNamesList[index].c_str(), core::rect<s32>(0,0,0,0));
+	return getAttributeAsRect(getNamesList()[index].c_str(), core::rect<s32>(0,0,0,0));
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::rect<s32>& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -890,6 +1198,15 @@ AttributeSource::addDimension2d(const c8* attributeName, const core::dimension2d
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::dimension2d<u32>& value) {
+	if ( nativeGeometry ) {
+		Cu::Variable*  v = obtainMemberVariable(attributeName);
+		if ( v ) {
+			Cu::Object*  r = new Dimension2(value);
+			v->setFuncReturn(r, false);
+			r->deref();
+		}
+		return;
+	}
 	// Break up into members labeled "width" and "height".
 	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
 
@@ -902,11 +1219,15 @@ AttributeSource::setAttribute(const c8* attributeName, const core::dimension2d<u
 core::dimension2d<u32>
 AttributeSource::getAttributeAsDimension2d(const c8* attributeName, const core::dimension2d<u32>& defaultNotFound) const {
 	// Get values from members labeled "width" and "height".
-	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
+	Cu::FunctionObject*  wrapperMember = findMemberByName(attributeName);
 	Cu::Object*  object;
 	core::dimension2d<u32>  out(defaultNotFound);
 
 	if ( wrapperMember ) {
+		object = getResultObject(wrapperMember);
+		if ( object && isDimension2Object(*object) )
+			return ((Dimension2*)object)->get();
+
 		object = getSubMemberFunctionResult(*wrapperMember, "width");
 		out.Width = getU32Value(object, defaultNotFound.Width);
 
@@ -918,13 +1239,13 @@ AttributeSource::getAttributeAsDimension2d(const c8* attributeName, const core::
 
 core::dimension2d<u32>
 AttributeSource::getAttributeAsDimension2d(s32 index) const {
-	return getAttributeAsDimension2d(infoNamesList[index].c_str(), core::dimension2d<u32>(0,0));
+	return getAttributeAsDimension2d(getNamesList()[index].c_str(), core::dimension2d<u32>(0,0));
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::dimension2d<u32>& value) {
 	// Take advantage of auto-creation of object-function members in Copper
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -935,6 +1256,10 @@ AttributeSource::addMatrix(const c8* attributeName, const core::matrix4& value)
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::matrix4& value) {
+	if ( nativeGeometry ) {
+		setFloatArrayMember(attributeName, value.pointer(), 16);
+		return;
+	}
 	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
 
 	if ( wrapperMember ) {
@@ -962,11 +1287,18 @@ AttributeSource::setAttribute(const c8* attributeName, const core::matrix4& valu
 
 core::matrix4
 AttributeSource::getAttributeAsMatrix(const c8* attributeName, const core::matrix4& defaultNotFound) const {
-	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
+	Cu::FunctionObject*  wrapperMember = findMemberByName(attributeName);
 	Cu::Object*  object;
 	core::matrix4  out(defaultNotFound);
+	const f32*  values;
 
 	if ( wrapperMember ) {
+		values = getFloatArrayValues(wrapperMember, 16);
+		if ( values ) {
+			out.setM(values);
+			return out;
+		}
+
 		object = getSubMemberFunctionResult(*wrapperMember, "v0");
 		out[0] = getF32Value(object, defaultNotFound[0]);
 
@@ -1020,12 +1352,12 @@ AttributeSource::getAttributeAsMatrix(const c8* attributeName, const core::matri
 
 core::matrix4
 AttributeSource::getAttributeAsMatrix(s32 index) const {
-	return getAttributeAsMatrix(infoNamesList[index].c_str(), core::matrix4());
+	return getAttributeAsMatrix(getNamesList()[index].c_str(), core::matrix4());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::matrix4& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -1036,6 +1368,11 @@ AttributeSource::addQuaternion(const c8* attributeName, const core::quaternion&
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::quaternion& value) {
+	if ( nativeGeometry ) {
+		const f32  values[4] = { value.X, value.Y, value.Z, value.W };
+		setFloatArrayMember(attributeName, values, 4);
+		return;
+	}
 	// Break up into members labeled "x", "y", "z", and "w".
 	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
 
@@ -1050,11 +1387,18 @@ AttributeSource::setAttribute(const c8* attributeName, const core::quaternion& v
 core::quaternion
 AttributeSource::getAttributeAsQuaternion(const c8* attributeName, const core::quaternion& defaultNotFound) const {
 	// Get values from members labeled "x", "y", "z", and "w".
-	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
+	Cu::FunctionObject*  wrapperMember = findMemberByName(attributeName);
 	Cu::Object*  object;
 	core::quaternion  out(defaultNotFound);
+	const f32*  values;
 
 	if ( wrapperMember ) {
+		values = getFloatArrayValues(wrapperMember, 4);
+		if ( values ) {
+			out.set(values[0], values[1], values[2], values[3]);
+			return out;
+		}
+
 		object = getSubMemberFunctionResult(*wrapperMember, "x");
 		out.X = getF32Value(object, defaultNotFound.X);
 
@@ -1072,12 +1416,12 @@ AttributeSource::getAttributeAsQuaternion(const c8* attributeName, const core::q
 
 core::quaternion
 AttributeSource::getAttributeAsQuaternion(s32 index) const {
-	return getAttributeAsQuaternion(infoNamesList[index].c_str(), core::quaternion());
+	return getAttributeAsQuaternion(getNamesList()[index].c_str(), core::quaternion());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::quaternion& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -1088,6 +1432,13 @@ AttributeSource::addBox3d(const c8* attributeName, const core::aabbox3df& value)
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::aabbox3df& value) {
+	if ( nativeGeometry ) {
+		const f32  values[6] = {
+			value.MinEdge.X, value.MinEdge.Y, value.MinEdge.Z,
+			value.MaxEdge.X, value.MaxEdge.Y, value.MaxEdge.Z };
+		setFloatArrayMember(attributeName, values, 6);
+		return;
+	}
 	// Break up into members that are sub-members of "min" and "max.
 	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
 	Cu::FunctionObject*  member;
@@ -1111,12 +1462,20 @@ AttributeSource::setAttribute(const c8* attributeName, const core::aabbox3df& va
 core::aabbox3df
 AttributeSource::getAttributeAsBox3d(const c8* attributeName, const core::aabbox3df& defaultNotFound) const {
 	// Get values from members that are sub-members of "min" and "max".
-	Cu::FunctionObject*  wrapperMember = getMemberByName(attributeName);
+	Cu::FunctionObject*  wrapperMember = findMemberByName(attributeName);
 	Cu::FunctionObject*  member;
 	Cu::Object*  object;
 	core::aabbox3df  out(defaultNotFound);
+	const f32*  values;
 
 	if ( wrapperMember ) {
+		values = getFloatArrayValues(wrapperMember, 6);
+		if ( values ) {
+			out.MinEdge.set(values[0], values[1], values[2]);
+			out.MaxEdge.set(values[3], values[4], values[5]);
+			return out;
+		}
+
 		member = getSubMemberByName(*wrapperMember, "min");
 		if ( member ) {
 			object = getSubMemberFunctionResult(*member, "x");
@@ -1145,12 +1504,12 @@ AttributeSource::getAttributeAsBox3d(const c8* attributeName, const core::aabbox
 
 core::aabbox3df
 AttributeSource::getAttributeAsBox3d(s32 index) const {
-	return getAttributeAsBox3d(infoNamesList[index].c_str(), core::aabbox3df());
+	return getAttributeAsBox3d(getNamesList()[index].c_str(), core::aabbox3df());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::aabbox3df& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -1161,6 +1520,11 @@ AttributeSource::addPlane3d(const c8* attributeName, const core::plane3df& value
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::plane3df& value) {
+	if ( nativeGeometry ) {
+		const f32  values[4] = { value.Normal.X, value.Normal.Y, value.Normal.Z, value.D };
+		setFloatArrayMember(attributeName, values, 4);
+		return;
+	}
 	// Break up into members labeled "x", "y", and "z".
 	Cu::FunctionObject*  member = getMemberByName(attributeName);
 
@@ -1171,10 +1535,18 @@ AttributeSource::setAttribute(const c8* attributeName, const core::plane3df& val
 
 core::plane3df
 AttributeSource::getAttributeAsPlane3d(const c8* attributeName, const core::plane3df& defaultNotFound) const {
-	Cu::FunctionObject*  member = getMemberByName(attributeName);
+	Cu::FunctionObject*  member = findMemberByName(attributeName);
 	core::plane3df  out(defaultNotFound);
+	const f32*  values;
 
 	if ( member ) {
+		values = getFloatArrayValues(member, 4);
+		if ( values ) {
+			out.Normal.set(values[0], values[1], values[2]);
+			out.D = values[3];
+			return out;
+		}
+
 		out.Normal = getAttributeAsVector3d(*member, "normal");
 		out.recalculateD(core::vector3df(0));
 	}
@@ -1183,12 +1555,12 @@ AttributeSource::getAttributeAsPlane3d(const c8* attributeName, const core::plan
 
 core::plane3df
 AttributeSource::getAttributeAsPlane3d(s32 index) const {
-	return getAttributeAsPlane3d(infoNamesList[index].c_str(), core::plane3df());
+	return getAttributeAsPlane3d(getNamesList()[index].c_str(), core::plane3df());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::plane3df& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -1199,6 +1571,14 @@ AttributeSource::addTriangle3d(const c8* attributeName, const core::triangle3df&
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::triangle3df& value) {
+	if ( nativeGeometry ) {
+		const f32  values[9] = {
+			value.pointA.X, value.pointA.Y, value.pointA.Z,
+			value.pointB.X, value.pointB.Y, value.pointB.Z,
+			value.pointC.X, value.pointC.Y, value.pointC.Z };
+		setFloatArrayMember(attributeName, values, 9);
+		return;
+	}
 	Cu::FunctionObject*  member = getMemberByName(attributeName);
 
 	if ( member ) {
@@ -1210,10 +1590,19 @@ AttributeSource::setAttribute(const c8* attributeName, const core::triangle3df&
 
 core::triangle3df
 AttributeSource::getAttributeAsTriangle3d(const c8* attributeName, const core::triangle3df& defaultNotFound) const {
-	Cu::FunctionObject*  member = getMemberByName(attributeName);
+	Cu::FunctionObject*  member = findMemberByName(attributeName);
 	core::triangle3df  out;
+	const f32*  values;
 
 	if ( member ) {
+		values = getFloatArrayValues(member, 9);
+		if ( values ) {
+			out.pointA.set(values[0], values[1], values[2]);
+			out.pointB.set(values[3], values[4], values[5]);
+			out.pointC.set(values[6], values[7], values[8]);
+			return out;
+		}
+
 		out.pointA = getAttributeAsVector3d(*member, "pointA");
 		out.pointB = getAttributeAsVector3d(*member, "pointB");
 		out.pointC = getAttributeAsVector3d(*member, "pointC");
@@ -1223,12 +1612,12 @@ AttributeSource::getAttributeAsTriangle3d(const c8* attributeName, const core::t
 
 core::triangle3df
 AttributeSource::getAttributeAsTriangle3d(s32 index) const {
-	return getAttributeAsTriangle3d(infoNamesList[index].c_str(), core::triangle3df());
+	return getAttributeAsTriangle3d(getNamesList()[index].c_str(), core::triangle3df());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::triangle3df& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -1239,6 +1628,11 @@ AttributeSource::addLine2d(const c8* attributeName, const core::line2df& value)
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::line2df& value) {
+	if ( nativeGeometry ) {
+		const f32  values[4] = { value.start.X, value.start.Y, value.end.X, value.end.Y };
+		setFloatArrayMember(attributeName, values, 4);
+		return;
+	}
 	Cu::FunctionObject*  member = getMemberByName(attributeName);
 
 	if ( member ) {
@@ -1249,10 +1643,18 @@ AttributeSource::setAttribute(const c8* attributeName, const core::line2df& valu
 
 core::line2df
 AttributeSource::getAttributeAsLine2d(const c8* attributeName, const core::line2df& defaultNotFound) const {
-	Cu::FunctionObject*  member = getMemberByName(attributeName);
+	Cu::FunctionObject*  member = findMemberByName(attributeName);
 	core::line2df  out = defaultNotFound;
+	const f32*  values;
 
 	if ( member ) {
+		values = getFloatArrayValues(member, 4);
+		if ( values ) {
+			out.start.set(values[0], values[1]);
+			out.end.set(values[2], values[3]);
+			return out;
+		}
+
 		out.start = getAttributeAsVector2d(*member, "start");
 		out.end = getAttributeAsVector2d(*member, "end");
 	}
@@ -1261,12 +1663,12 @@ AttributeSource::getAttributeAsLine2d(const c8* attributeName, const core::line2
 
 core::line2df
 AttributeSource::getAttributeAsLine2d(s32 index) const {
-	return getAttributeAsLine2d(infoNamesList[index].c_str(), core::line2df());
+	return getAttributeAsLine2d(getNamesList()[index].c_str(), core::line2df());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::line2df& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -1277,6 +1679,13 @@ AttributeSource::addLine3d(const c8* attributeName, const core::line3df& value)
 
 void
 AttributeSource::setAttribute(const c8* attributeName, const core::line3df& value) {
+	if ( nativeGeometry ) {
+		const f32  values[6] = {
+			value.start.X, value.start.Y, value.start.Z,
+			value.end.X, value.end.Y, value.end.Z };
+		setFloatArrayMember(attributeName, values, 6);
+		return;
+	}
 	Cu::FunctionObject*  member = getMemberByName(attributeName);
 
 	if ( member ) {
@@ -1287,10 +1696,18 @@ AttributeSource::setAttribute(const c8* attributeName, const core::line3df& valu
 
 core::line3df
 AttributeSource::getAttributeAsLine3d(const c8* attributeName, const core::line3df& defaultNotFound) const {
-	Cu::FunctionObject*  member = getMemberByName(attributeName);
+	Cu::FunctionObject*  member = findMemberByName(attributeName);
 	core::line3df  out = defaultNotFound;
+	const f32*  values;
 
 	if ( member ) {
+		values = getFloatArrayValues(member, 6);
+		if ( values ) {
+			out.start.set(values[0], values[1], values[2]);
+			out.end.set(values[3], values[4], values[5]);
+			return out;
+		}
+
 		out.start = getAttributeAsVector3d(*member, "start");
 		out.end = getAttributeAsVector3d(*member, "end");
 	}
@@ -1299,12 +1716,12 @@ AttributeSource::getAttributeAsLine3d(const c8* attributeName, const core::line3
 
 core::line3df
 AttributeSource::getAttributeAsLine3d(s32 index) const {
-	return getAttributeAsLine3d(infoNamesList[index].c_str(), core::line3df());
+	return getAttributeAsLine3d(getNamesList()[index].c_str(), core::line3df());
 }
 
 void
 AttributeSource::setAttribute(s32 index, const core::line3df& value) {
-	setAttribute(infoNamesList[index].c_str(), value);
+	setAttribute(getNamesList()[index].c_str(), value);
 }
 
 void
@@ -1327,6 +1744,7 @@ AttributeSource::setAttribute(const c8* attributeName, video::ITexture* texture,
 	}
 
 	if ( !texture ) {
+		std::lock_guard<std::mutex>  lock( getImageDecodeLock() );
 		textureObject = new Texture(videoDriver->getTexture(filename));
 	} else {
 		textureObject = new Texture(texture);
@@ -1343,18 +1761,21 @@ AttributeSource::getAttributeAsTexture(const c8* attributeName, video::ITexture*
 		if ( isTextureObject(*object) ) {
 			return ((Texture*)object)->getTexture();
 		}
+		if ( isSpriteObject(*object) ) {
+			return ((Sprite*)object)->getTexture();
+		}
 	}
 	return defaultNotFound;
 }
 
 video::ITexture*
 AttributeSource::getAttributeAsTexture(s32 index) const {
-	return getAttributeAsTexture(infoNamesList[index].c_str(), 0);
+	return getAttributeAsTexture(getNamesList()[index].c_str(), 0);
 }
 
 void
 AttributeSource::setAttribute(s32 index, video::ITexture* texture, const io::path& filename) {
-	setAttribute(infoNamesList[index].c_str(), texture, filename);
+	setAttribute(getNamesList()[index].c_str(), texture, filename);
 }
 
 void
@@ -1375,12 +1796,12 @@ AttributeSource::getAttributeAsUserPointer(const c8* attributeName, void* defaul
 
 void*
 AttributeSource::getAttributeAsUserPointer(s32 index) const {
-	return getAttributeAsUserPointer(infoNamesList[index].c_str(), 0);
+	return getAttributeAsUserPointer(getNamesList()[index].c_str(), 0);
 }
 
 void
 AttributeSource::setAttribute(s32 index, void* userPointer) {
-	setAttribute(infoNamesList[index].c_str(), userPointer);
+	setAttribute(getNamesList()[index].c_str(), userPointer);
 }
 
 
@@ -11,11 +11,14 @@
 #include <Strings.h> // from Copper
 #include <Copper.h>
 #include "cubr_defs.h"
+#include "cubr_strmap.h"
 
 namespace cubr {
 
 using namespace irr;
 
+class Sprite;
+
 //! Helper functions
 //! Second parameter is the default value if the object is not numeric
 bool getBoolValue( Cu::Object*, bool );
@@ -29,19 +32,69 @@ f32 getF32Value( Cu::Object*, f32 );
 	we use the irr::IAttributes interface.
 	This implementation accepts a variable and uses it as the source of data. The data is extracted from the
 	variable during one of the "get" calls to the interface.
+	Member variables are resolved once and kept in an index, so the many getAttributeAs*() calls
+	made by deserializeAttributes() neither search a list nor allocate a Copper string.
+	The index is a small open-addressed table inside the source, keyed by the ID of the name in a program-wide
+	table of attribute names. That table holds the one Copper string made for each name asked for by Irrlicht
+	(or cubr's own setters), so even the first search for a name allocates nothing once another
+	AttributeSource has searched for it. Member names the script adds are never put in the table.
+	The member names are only enumerated when one of the index-based methods (getAttributeCount(),
+	getAttributeName(), the (s32 index) overloads) is first called. Irrlicht's deserializeAttributes() only
+	searches by name, so normally this never happens.
+	When a projection is given (via project()), attributes with other names are ignored by the setters,
+	so serializeAttributes() only creates the members that were asked for.
+	Rectangles, positions, 2D vectors and dimensions may be given as either member functions
+	(x, y, x2, y2 / width, height) or cubr geometry objects (see cubr_geom.h). Matrices, quaternions, boxes,
+	planes, triangles and lines may likewise be given as a FloatArray. The setters only produce these
+	objects when nativeGeometry is set.
+	A texture may be given as an atlas sprite (see cubr_atlas.h). The matching rectangle attribute
+	(such as "ImageRect" for "Image") is then the area of the sprite.
 */
 class AttributeSource : public irr::io::IAttributes, public Cu::AppendObjectInterface {
 
 	typedef  util::List<util::String>  slist_t;
 
+	struct MemberSlot {
+		s32  nameId; // -1 for an empty slot
+		s32  listIndex; // Position in the names list, -1 until listed
+		Cu::Variable*  variable; // Null if there is no such member
+	};
+
+	// Irrlicht's elements have fewer attributes than this, so the index never fills in practice
+	enum { MEMBER_INDEX_SIZE = 64, MEMBER_INDEX_MAX = 48 };
+
 	video_driver_t*  videoDriver; // For loading textures
 	Cu::FunctionObject&  infoSource;
-	slist_t  infoNamesList;
+	mutable slist_t  infoNamesList;
+	mutable bool  infoNamesListed;
+	// Variables in the persistent scope of infoSource by name ID (see getAttributeNameId() in cubr_attr.cpp).
+	// Names that were searched for but not found are kept with a null variable. Once MEMBER_INDEX_MAX names
+	// are held, other names are searched for in the scope each time.
+	// Setters may add variables to the scope, so they flag the index for rebuilding.
+	mutable MemberSlot  memberIndex[MEMBER_INDEX_SIZE];
+	mutable u32  memberIndexCount;
+	mutable bool  memberIndexComplete; // All members are in the index, so a miss means there is no such member
+	mutable bool  memberIndexStale;
+	// Names of the only attributes that may be set, if projecting
+	StringMap<bool>  projection;
+	bool  projecting;
+	// Store rectangles, 2D vectors/positions, dimensions and the many-numbered types (matrices, etc.)
+	// as cubr geometry objects rather than member functions
+	bool  nativeGeometry;
 
 public:
 
-	AttributeSource( video_driver_t*, Cu::FunctionObject& );
+	AttributeSource( video_driver_t*, Cu::FunctionObject&, bool nativeGeometry = false );
+
+	//! Adds a name to the projection. Once any name is added, only attributes in the projection can be set.
+	void project(const c8*);
+
+	//! Returns the variable for the given member of the info source or null if there is no such member.
+	//! Does not create the member.
+	Cu::Variable* findMemberVariable(const c8*) const;
+	Cu::FunctionObject* findMemberByName(const c8*) const;
 
+	//! Returns the given member of the info source, creating it if it does not exist.
 	Cu::FunctionObject* getMemberByName(const c8*) const;
 	Cu::FunctionObject* getSubMemberByName(Cu::FunctionObject&, const c8*) const;
 	Cu::Object*  getMemberFunctionResult(const c8*) const;
@@ -58,6 +111,22 @@ public:
 	void  setSubMemberFunctionResult(Cu::FunctionObject&, const c8*, core::vector2df);
 	void  setSubMemberFunctionResult(Cu::FunctionObject&, const c8*, core::vector3df);
 
+protected:
+	void  resetMemberIndex() const;
+	//! Returns the slot of the name, adding it if create is set and the index is not full, or null.
+	MemberSlot*  getMemberSlot(u32 nameId, bool create) const;
+	const slist_t&  getNamesList() const;
+
+	//! Stores the values in the named member as a FloatArray (see cubr_geom.h)
+	void  setFloatArrayMember(const c8*, const f32*, u32);
+	Cu::Variable*  obtainMemberVariable(const c8*) const;
+
+	//! Returns the sprite given for the image attribute matching the rectangle attribute
+	//! (such as "Image" for "ImageRect") or null if there is none.
+	Sprite*  findSpriteForRect(const c8*) const;
+
+public:
+
 	// ***** From Copper *****
 
 	// AppendObjectInterface
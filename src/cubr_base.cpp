@@ -3,6 +3,8 @@
 #include "cubr_base.h"
 #include "cubr_str.h"
 #include "cubr_attr.h"
+#include "cubr_setattr.h"
+#include "cubr_marshal.h"
 #include <irrList.h>
 
 namespace cubr {
@@ -105,10 +107,28 @@ GUIElement::initialize( Cu::FunctionObject& infoSource ) {
 //
 //}
 
-//bool
-//GUIElement::setAttribute( const util::String&, Cu::FunctionObject* ) { // name, value storage
-//
-//}
+bool
+GUIElement::setAttribute( const irr::c8*  name, AttributeSource&  attrs, const AttributeSetterTable&  setters ) {
+	AttributeSetter  setter = setters.find( data.access().getType(), name );
+	if ( ! setter )
+		return false;
+	return setter( data.get(), attrs, name );
+}
+
+void
+GUIElement::setAttributes( AttributeSource&  attrs, const AttributeSetterTable&  setters ) {
+	const irr::u32  count = attrs.getAttributeCount();
+	bool  hasUnsetAttributes = false;
+	irr::u32  i = 0;
+	for (; i < count; ++i) {
+		if ( ! setAttribute( attrs.getAttributeName(i), attrs, setters ) )
+			hasUnsetAttributes = true;
+	}
+	// Irrlicht elements read all of their attributes at once, so this is only worth it for names
+	// the table does not know (such as those of custom elements).
+	if ( hasUnsetAttributes )
+		data.access().deserializeAttributes(&attrs);
+}
 
 void
 GUIElement::setEnabled( Cu::BoolObject&  settingObject ) {
@@ -122,49 +142,10 @@ GUIElement::setVisible( Cu::BoolObject&  settingObject ) {
 
 void
 GUIElement::setRelativePosition( Cu::FunctionObject& infoSource ) {
-	irr::core::recti  pos(0,0,0,0);
-	Cu::Function*  f;
-	Cu::Scope*  scope;
-	util::String  name_x("x"),
-					name_y("y"),
-					name_x2("x2"),
-					name_y2("y2");
-	Cu::Variable*  var;
-	Cu::Object*  resultObj;
-
-	// Extract the values
-	if ( infoSource.getFunction(f) ) {
-		scope = &(f->getPersistentScope());
-
-		scope->getVariable(name_x, var);
-		if ( var->getFunction(REAL_NULL)->result.obtain(resultObj) ) {
-			if ( Cu::isNumericObject( *resultObj ) ) {
-				pos.UpperLeftCorner.X = ((Cu::NumericObject*)resultObj)->getIntegerValue();
-			}
-		}
-
-		scope->getVariable(name_y, var);
-		if ( var->getFunction(REAL_NULL)->result.obtain(resultObj) ) {
-			if ( Cu::isNumericObject( *resultObj ) ) {
-				pos.UpperLeftCorner.Y = ((Cu::NumericObject*)resultObj)->getIntegerValue();
-			}
-		}
-
-		scope->getVariable(name_x2, var);
-		if ( var->getFunction(REAL_NULL)->result.obtain(resultObj) ) {
-			if ( Cu::isNumericObject( *resultObj ) ) {
-				pos.LowerRightCorner.X = ((Cu::NumericObject*)resultObj)->getIntegerValue();
-			}
-		}
-
-		scope->getVariable(name_y2, var);
-		if ( var->getFunction(REAL_NULL)->result.obtain(resultObj) ) {
-			if ( Cu::isNumericObject( *resultObj ) ) {
-				pos.LowerRightCorner.Y = ((Cu::NumericObject*)resultObj)->getIntegerValue();
-			}
-		}
-
-		data.access().setRelativePosition(pos);
+	// Members that are missing are zero
+	RectI  pos = { 0, 0, 0, 0 };
+	if ( Marshal<RectI>::fromCopper(infoSource, pos) ) {
+		data.access().setRelativePosition( pos.toRect() );
 	}
 }
 
@@ -204,27 +185,7 @@ GUIElement::isVisible() {
 
 void
 GUIElement::getRelativePosition( Cu::FunctionObject& storage ) {
-	irr::core::recti  pos = ((gui_element_t&)data.access()).getRelativePosition();
-	Cu::Function*  f;
-	Cu::Scope*  scope;
-	util::String  name_x("x"),
-				name_y("y"),
-				name_x2("x2"),
-				name_y2("y2");
-	// Note: Declaring a Copper object that will die in this local scope only works because
-	// the method Variable::setFuncReturn (via setVariableFrom) defaults to copying.
-	Cu::IntegerObject  x( (Cu::Integer) pos.UpperLeftCorner.X ),
-					y( (Cu::Integer) pos.UpperLeftCorner.Y ),
-					x2( (Cu::Integer) pos.LowerRightCorner.X ),
-					y2( (Cu::Integer) pos.LowerRightCorner.Y );
-
-	if ( storage.getFunction(f) ) {
-		scope = &(f->getPersistentScope());
-		scope->setVariableFrom(name_x, x, false); // Reuse of storage means nothing here. Default is copy.
-		scope->setVariableFrom(name_y, y, false);
-		scope->setVariableFrom(name_x2, x2, false);
-		scope->setVariableFrom(name_y2, y2, false);
-	}
+	Marshal<RectI>::toCopper( RectI::from( ((gui_element_t&)data.access()).getRelativePosition() ), &storage );
 }
 
 irr::u32
@@ -305,24 +266,236 @@ GUIElement::pullResultObject( Cu::FunctionObject* src ) {
 	}
 }
 
-Image::Image( image_t* t, video_driver_t* v )
+Image::Image( image_t* t, video_driver_t* v, bool  isView )
 	: Cu::Object( Image::getTypeAsCuType() )
 	, data()
 	, videoDriver(v)
+	, prevShare(this)
+	, nextShare(this)
+	, dirtyRect()
+	, view(isView)
+	, parent(0)
+	, region()
 {
 	data.set(t);
+	setAllDirty();
+}
+
+Image::Image( Image&  p, const rect_t&  area )
+	: Cu::Object( Image::getTypeAsCuType() )
+	, data()
+	, videoDriver(p.videoDriver)
+	, prevShare(this)
+	, nextShare(this)
+	, dirtyRect()
+	, view(false)
+	, parent(&p)
+	, region(area)
+{
+	// Views of views share the pixels of the original image
+	if ( p.parent ) {
+		parent = p.parent;
+		region += p.region.UpperLeftCorner;
+		region.clipAgainst( p.region );
+	} else if ( p.getImage() ) {
+		region.clipAgainst( rect_t( irr::core::vector2di(0,0), p.getImage()->getDimension() ) );
+	}
+	if ( region.getWidth() < 0 || region.getHeight() < 0 )
+		region = rect_t( region.UpperLeftCorner, region.UpperLeftCorner );
+	parent->ref();
+}
+
+Image::~Image() {
+	unshare();
+	if ( parent )
+		parent->deref();
 }
 
 image_t*
 Image::getImage() {
+	if ( parent )
+		return parent->getImage();
 	return data.get();
 }
 
+image_t*
+Image::getWritableImage() {
+	if ( parent )
+		return parent->getWritableImage();
+	if ( isShared() && data ) {
+		image_t*  img = videoDriver->createImage(data.access().getColorFormat(), data.access().getDimension());
+		data.access().copyTo(img);
+		data.set(img);
+		img->drop();
+		unshare();
+	}
+	return data.get();
+}
+
+bool
+Image::isShared() const {
+	return nextShare != this;
+}
+
+void
+Image::share( Image&  other ) {
+	if ( &other == this || parent || view || other.parent || other.view )
+		return;
+	unshare();
+	data.set( other.data.get() );
+	prevShare = &other;
+	nextShare = other.nextShare;
+	other.nextShare->prevShare = this;
+	other.nextShare = this;
+}
+
+video_driver_t*
+Image::getVideoDriver() {
+	return videoDriver;
+}
+
+bool
+Image::isRegion() const {
+	return notNull(parent);
+}
+
+Image*
+Image::getParent() {
+	return parent;
+}
+
+rect_t
+Image::getRegion() {
+	if ( parent )
+		return region;
+	if ( data )
+		return rect_t( irr::core::vector2di(0,0), data.access().getDimension() );
+	return rect_t();
+}
+
+irr::core::dimension2du
+Image::getSize() {
+	if ( ! getImage() )
+		return irr::core::dimension2du(0,0);
+	const rect_t  area = getRegion();
+	return irr::core::dimension2du( (irr::u32)area.getWidth(), (irr::u32)area.getHeight() );
+}
+
+bool
+Image::lockPixels( PixelRect&  out, bool  writing ) {
+	image_t*  img = writing ? getWritableImage() : getImage();
+	if ( ! img )
+		return false;
+	const rect_t  area = getRegion();
+	out.format = img->getColorFormat();
+	out.pitch = img->getPitch();
+	out.bytesPerPixel = img->getBytesPerPixel();
+	out.size = irr::core::dimension2du( (irr::u32)area.getWidth(), (irr::u32)area.getHeight() );
+	out.base = (irr::u8*)img->lock();
+	out.base = out.at( area.UpperLeftCorner.X, area.UpperLeftCorner.Y );
+	return true;
+}
+
+void
+Image::unlockPixels() {
+	image_t*  img = getImage();
+	if ( img )
+		img->unlock();
+}
+
+bool
+Image::isView() const {
+	if ( parent )
+		return parent->isView();
+	return view;
+}
+
+void
+Image::detach() {
+	data.set(0);
+	dirtyRect = rect_t();
+}
+
+void
+Image::addDirtyRect( const rect_t&  area ) {
+	if ( parent ) {
+		rect_t  clipped = area + region.UpperLeftCorner;
+		clipped.clipAgainst( region );
+		parent->addDirtyRect( clipped );
+		return;
+	}
+	if ( ! data )
+		return;
+	rect_t  clipped = area;
+	clipped.clipAgainst( rect_t( irr::core::vector2di(0,0), data.access().getDimension() ) );
+	if ( clipped.getWidth() <= 0 || clipped.getHeight() <= 0 )
+		return;
+	if ( isDirty() ) {
+		dirtyRect.addInternalPoint( clipped.UpperLeftCorner );
+		dirtyRect.addInternalPoint( clipped.LowerRightCorner );
+	} else {
+		dirtyRect = clipped;
+	}
+}
+
+void
+Image::setAllDirty() {
+	if ( parent )
+		parent->addDirtyRect( region );
+	else if ( data )
+		dirtyRect = rect_t( irr::core::vector2di(0,0), data.access().getDimension() );
+}
+
+rect_t
+Image::getDirtyRect() const {
+	if ( ! parent )
+		return dirtyRect;
+	if ( ! parent->isDirty() )
+		return rect_t();
+	rect_t  area = parent->dirtyRect;
+	area.clipAgainst( region );
+	if ( area.getWidth() <= 0 || area.getHeight() <= 0 )
+		return rect_t();
+	return area - region.UpperLeftCorner;
+}
+
+bool
+Image::isDirty() const {
+	const rect_t  area = getDirtyRect();
+	return area.getWidth() > 0 && area.getHeight() > 0;
+}
+
+void
+Image::clearDirty() {
+	// The parent's changes may still be needed by other textures, so region views leave them
+	if ( ! parent )
+		dirtyRect = rect_t();
+}
+
+void
+Image::unshare() {
+	prevShare->nextShare = nextShare;
+	nextShare->prevShare = prevShare;
+	prevShare = this;
+	nextShare = this;
+}
+
 Cu::Object*
 Image::copy() {
-	image_t*  img = videoDriver->createImage(data.access().getColorFormat(), data.access().getDimension());
-	Image*  out = new Image(img, videoDriver);
-	img->drop();
+	if ( parent )
+		return new Image(*parent, region);
+	if ( view ) {
+		// Copies are the same object so that they are emptied with it when the texture is unlocked
+		this->ref();
+		return this;
+	}
+	// Shares the buffer until one of the copies is changed
+	Image*  out = new Image(data.get(), videoDriver);
+	out->dirtyRect = dirtyRect;
+	out->prevShare = this;
+	out->nextShare = nextShare;
+	nextShare->prevShare = out;
+	nextShare = out;
 	return out;
 }
 
@@ -344,22 +517,76 @@ Image::supportsInterface( Cu::ObjectType::Value  value ) const {
 Texture::Texture( texture_t* t )
 	: Cu::Object( Texture::getTypeAsCuType() )
 	, data()
+	, lockedView(0)
 {
 	data.set(t);
 }
 
+Texture::~Texture() {
+	unlock();
+}
+
 texture_t*
 Texture::getTexture() {
 	return data.get();
 }
 
+Image*
+Texture::lock( video_driver_t*  driver ) {
+	if ( lockedView )
+		return lockedView;
+	if ( ! data )
+		return 0;
+
+	texture_t&  tex = data.access();
+	const irr::video::ECOLOR_FORMAT  format = tex.getColorFormat();
+	const irr::core::dimension2du  size = tex.getSize();
+	// The image must use the texture memory as is, so rows cannot be padded
+	if ( tex.getPitch() != size.Width * irr::video::IImage::getBitsPerPixelFromFormat(format) / 8 )
+		return 0;
+
+	void*  memory = tex.lock( irr::video::ETLM_READ_WRITE );
+	if ( ! memory )
+		return 0;
+
+	// Wraps the memory without copying or taking ownership of it
+	image_t*  img = driver->createImageFromData( format, size, memory, true, false );
+	if ( ! img ) {
+		tex.unlock();
+		return 0;
+	}
+	lockedView = new Image(img, driver, true);
+	lockedView->clearDirty();
+	img->drop();
+	return lockedView;
+}
+
+void
+Texture::unlock() {
+	if ( ! lockedView )
+		return;
+	lockedView->detach();
+	lockedView->deref();
+	lockedView = 0;
+	data.access().unlock();
+	if ( data.access().hasMipMaps() )
+		data.access().regenerateMipMapLevels();
+}
+
+bool
+Texture::isLocked() const {
+	return notNull(lockedView);
+}
+
 Cu::Object*
 Texture::copy() {
 	// Technically, a new texture (copied from the original) should be created with the video driver
 	// by means of the environment. However, this texture would need a unique name, and that would mess
 	// up whenever two copies of the same texture are made.
 	// Finally, it should never be necessary to create a texture copy anyways. Only images need to be editable.
-	return new Texture(data.get());
+	// Copies are the same object so that they share the lock (see lock()).
+	this->ref();
+	return this;
 }
 
 void
@@ -13,6 +13,9 @@ namespace cubr {
 using util::String;
 using irr::tools::irrptr;
 
+class AttributeSource;
+class AttributeSetterTable;
+
 // Set however you wish.
 // It will be incremented by ObjectType::UnknownData + 1 in the object type return.
 #define CUBR_TYPE_START_INDEX 0
@@ -25,6 +28,16 @@ enum Value {
 	Texture,
 	JSONStorage,
 	JSONAccessor,
+	Rect,
+	Vector2,
+	Dimension2,
+	FloatArray,
+	PixelBuffer,
+	ImageJob,
+	Atlas,
+	Sprite,
+	ImageLoad,
+	GUIEvent,
 
 	LAST_INDEX, // Total number of types + starting index
 	FORCE_32BIT = 0x7fffffff, // NOT A TYPE. Forces enumeration to compile to 32 bits
@@ -42,6 +55,20 @@ isImageObject( Cu::Object& );
 bool
 isTextureObject( Cu::Object& );
 
+//! Locked pixels of an image or of a region of one (see Image::lockPixels())
+struct PixelRect {
+	irr::u8*  base; // First pixel of the region
+	irr::u32  pitch;
+	irr::u32  bytesPerPixel;
+	irr::video::ECOLOR_FORMAT  format;
+	irr::core::dimension2du  size;
+
+	irr::u8*
+	at( irr::s32  x, irr::s32  y ) const {
+		return base + (irr::u32)y * pitch + (irr::u32)x * bytesPerPixel;
+	}
+};
+
 //! Wrapper for a GUI element
 class GUIElement : public Cu::Object {
 
@@ -93,12 +120,17 @@ public:
 	//bool
 	//setAttributeByString( const util::String&, const util::String& ); // name, value
 
-		// WANTED!
-	//! Set the attribute of the given name with the given value
-	// Defers to setExtraAttributeByFunctionObject() if no attribute found.
-	// gui_set_attribute(element: "attribute" value:)
-	//bool
-	//setAttribute( const util::String&, Cu::FunctionObject* ); // name, value storage
+	//! Set the attribute of the given name with the value of the same name in the given source
+	// Uses the element's own setter, found in the given table, rather than deserializeAttributes().
+	// Returns false if the table has no setter for the attribute.
+	bool
+	setAttribute( const irr::c8*, AttributeSource&, const AttributeSetterTable& );
+
+	//! Set each of the attributes in the given source
+	// Attributes without a direct setter are applied together via deserializeAttributes().
+	// gui_set(element: attributes:)
+	void
+	setAttributes( AttributeSource&, const AttributeSetterTable& );
 
 	// Only necessary for explicit calls (faster than setting by attribute name)
 	// (i.e. gui_set_enabled(element:) )
@@ -211,17 +243,103 @@ protected:
 };
 */
 
+//! Image
+/*
+	Copies share the same image buffer (copy-on-write).
+	Copies sharing a buffer are linked in a ring. Use getWritableImage() before changing the pixels so that a
+	shared buffer is first cloned for this copy alone.
+*/
 class Image : public Cu::Object {
 
 	irrptr<image_t>  data;
 	video_driver_t*  videoDriver;
+	Image*  prevShare;
+	Image*  nextShare;
+	rect_t  dirtyRect;
+	bool  view;
+	Image*  parent; // Image whose pixels a region view shares
+	rect_t  region;
 
 public:
-	Image( image_t*, video_driver_t* );
+	//! The whole image starts dirty since no texture has been made from it yet.
+	//! A view wraps memory owned by something else, such as a locked texture (see Texture::lock()).
+	//! Views are never shared, so copies of them are the same object.
+	Image( image_t*, video_driver_t*, bool  isView = false );
 
+	//! Creates a region view, which shares the pixels of the area of the parent, clipped to the parent.
+	//! Changes to either are seen by both. Copies of a region view are views of the same region.
+	Image( Image&  parent, const rect_t&  area );
+
+	~Image();
+
+	//! Returns the image for reading. Do not change the pixels.
+	//! For a region view, this is the whole image of the parent (see getRegion()).
 	image_t*
 	getImage();
 
+	//! Returns the image for changing, cloning it first if it is shared with other copies.
+	image_t*
+	getWritableImage();
+
+	video_driver_t*
+	getVideoDriver();
+
+	bool
+	isRegion() const;
+
+	//! Returns the image a region view shares pixels with, or null if this is not a region view.
+	Image*
+	getParent();
+
+	//! Area of getImage() that this image covers. For images that are not region views, it is the whole image.
+	rect_t
+	getRegion();
+
+	irr::core::dimension2du
+	getSize();
+
+	//! Locks the pixels of the image or region, for changing if writing is true.
+	//! Returns false if there are no pixels. Otherwise, unlockPixels() must be called.
+	bool
+	lockPixels( PixelRect&, bool  writing );
+
+	void
+	unlockPixels();
+
+	bool
+	isShared() const;
+
+	//! Drops the pixels of this image and shares those of the other, as if this were a copy of it.
+	//! Neither image may be a view.
+	void
+	share( Image& );
+
+	bool
+	isView() const;
+
+	//! Drops the image of a view once its memory is no longer valid, leaving the view empty.
+	void
+	detach();
+
+	//! Adds the area to the region changed since the last texture update. The area is clipped to the image.
+	//! Region views pass their changes on to the parent.
+	void
+	addDirtyRect( const rect_t& );
+
+	void
+	setAllDirty();
+
+	//! Returns the region changed since the last texture update. It is empty if nothing has changed.
+	//! For region views, it is the part of the parent's changed region within the view.
+	rect_t
+	getDirtyRect() const;
+
+	bool
+	isDirty() const;
+
+	void
+	clearDirty();
+
 	// ** Cu::Object virtual methods **
 
 	virtual Cu::Object*
@@ -246,18 +364,37 @@ public:
 	getTypeAsCuType() {
 		return getCubrTypeAsCuType( CubrObjectType::Image );
 	}
+
+private:
+	void
+	unshare();
 };
 
 class Texture : public Cu::Object {
 
 	irrptr<texture_t>  data;
+	Image*  lockedView;
 
 public:
 	Texture( texture_t* );
 
+	~Texture();
+
 	texture_t*
 	getTexture();
 
+	//! Locks the texture and returns an image view of its memory, or null if the texture cannot be viewed.
+	//! Locking again returns the same view.
+	Image*
+	lock( video_driver_t*  driver );
+
+	//! Unlocks the texture and empties the view returned by lock().
+	void
+	unlock();
+
+	bool
+	isLocked() const;
+
 	// ** Cu::Object virtual methods **
 
 	virtual Cu::Object*
@@ -7,9 +7,67 @@ namespace cubr {
 
 using namespace irr::gui;
 
+EventHandler::ArgFrame::ArgFrame()
+	: callerId(REAL_NULL)
+	, elementId(REAL_NULL)
+	, payload(REAL_NULL)
+	, args()
+{}
+
+EventHandler::ArgFrame::~ArgFrame() {
+	if ( callerId )
+		callerId->deref();
+	if ( elementId )
+		elementId->deref();
+	if ( payload )
+		payload->deref();
+}
+
+util::List<Cu::Object*>*
+EventHandler::ArgFrame::set( const irr::SEvent::SGUIEvent&  event ) {
+	bool  changed = false;
+
+	// A callback may have kept the last event, which must not change under it
+	if ( payload && payload->getReferenceCount() > 1 ) {
+		payload->deref();
+		payload = REAL_NULL;
+	}
+	if ( ! payload ) {
+		payload = new GUIEvent();
+		changed = true;
+	}
+	payload->set(event);
+
+	// Integer objects cannot be changed, but they can be shared, so new ones are only made for new IDs
+	if ( ! callerId || callerId->getIntegerValue() != payload->getCallerId() ) {
+		if ( callerId )
+			callerId->deref();
+		callerId = new Cu::IntegerObject( payload->getCallerId() );
+		changed = true;
+	}
+	if ( ! elementId || elementId->getIntegerValue() != payload->getElementId() ) {
+		if ( elementId )
+			elementId->deref();
+		elementId = new Cu::IntegerObject( payload->getElementId() );
+		changed = true;
+	}
+
+	if ( changed ) {
+		args.clear();
+		args.push_back(callerId);
+		args.push_back(elementId);
+		args.push_back(payload);
+	}
+	return &args;
+}
+
 EventHandler::EventHandler( Cu::Engine& e )
 	: engine(e)
+	, eventQueue(e)
 {
+	bindFFI(engine, "event_get", &GetGUIEventMember);
+	bindFFI(engine, "gui_coalesce", &eventQueue, &GUIEventQueue::gui_coalesce);
+	bindFFI(engine, "event_stats", &eventQueue, &GUIEventQueue::event_stats);
 	guiEventCallbacks[ EGET_ELEMENT_FOCUS_LOST		].registerAs(engine, "gui_on_focus_lost");
 	guiEventCallbacks[ EGET_ELEMENT_FOCUSED			].registerAs(engine, "gui_on_focused");
 	guiEventCallbacks[ EGET_ELEMENT_HOVERED			].registerAs(engine, "gui_on_hovered");
@@ -55,24 +113,32 @@ EventHandler::OnEvent(const irr::SEvent& event) {
 	return false;
 }
 
+irr::u32
+EventHandler::pump( irr::u32  budget ) {
+	return eventQueue.pump(budget);
+}
+
+GUIEventQueue&
+EventHandler::getEventQueue() {
+	return eventQueue;
+}
+
 bool
 EventHandler::OnGUIEvent(const irr::SEvent::SGUIEvent& event) {
 	if ( !event.Caller )
 		return false;
 
-	Cu::Integer  callerId = event.Caller->getID();
-	Cu::Integer  elemId = (event.Element? event.Element->getID() : -1);
-
-	Cu::IntegerObject  callerIDObject(callerId);
-	Cu::IntegerObject  elemIDObject(elemId);
-
 	EventCallback&  cb = guiEventCallbacks[event.EventType];
-	util::List<Cu::Object*>  args;
-	args.push_back( &callerIDObject );
-	args.push_back( &elemIDObject );
 	Cu::Object*  returnObject;
 
-	if ( cb.run( engine, &args ) ) {
+	if ( ! cb.isSet() )
+		return false;
+
+	// Coalesced events cannot be marked as handled, since their callbacks have yet to run
+	if ( eventQueue.enqueue( cb.get(), event, true ) )
+		return false;
+
+	if ( cb.run( engine, guiEventArgs[event.EventType].set(event) ) ) {
 		returnObject = engine.getLastObject();
 		if ( Cu::isBoolObject(*returnObject) ) {
 			return ((Cu::BoolObject*)returnObject)->getValue();
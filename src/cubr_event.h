@@ -5,6 +5,8 @@
 
 #include <IEventReceiver.h>
 #include <Copper.h>
+#include "cubr_guievent.h"
+#include "cubr_evqueue.h"
 
 namespace cubr {
 
@@ -12,6 +14,9 @@ namespace cubr {
 /*
 	Handles user event callbacks created in Copper.
 	Normally, you would call the OnEvent of this inside that of an application-wide event handler.
+	Callbacks of events whose coalescing policy is not immediate (see gui_coalesce() and cubr_evqueue.h)
+	are run by pump(), which should then be called once per frame.
+	To keep all callbacks out of OnEvent(), use getEventQueue().setPolicy(EventCoalescing::Deferred).
 */
 class EventHandler : public irr::IEventReceiver {
 public:
@@ -49,6 +54,14 @@ public:
 			return callback && (callback == container);
 		}
 
+		bool isSet() const {
+			return notNull(callback);
+		}
+
+		Cu::FunctionObject* get() const {
+			return callback;
+		}
+
 		bool run( Cu::Engine& engine, util::List<Cu::Object*>* args ) {
 			if ( isNull(callback) )
 				return false;
@@ -57,10 +70,34 @@ public:
 		}
 	};
 
+	//! Arguments for a callback: the caller ID, the element ID and the GUIEvent.
+	/*
+		Kept between events so that repeated events from the same elements (such as hovering or
+		dragging a scrollbar) allocate nothing. The ID objects are only replaced when the IDs change,
+		and the event object only when a callback has kept it.
+	*/
+	class ArgFrame {
+		Cu::IntegerObject*  callerId;
+		Cu::IntegerObject*  elementId;
+		GUIEvent*  payload;
+		util::List<Cu::Object*>  args;
+
+	public:
+		ArgFrame();
+
+		~ArgFrame();
+
+		//! Updates the arguments from the event and returns them
+		util::List<Cu::Object*>*
+		set( const irr::SEvent::SGUIEvent& );
+	};
+
 private:
 
 	Cu::Engine&  engine;
 	EventCallback  guiEventCallbacks[irr::gui::EGET_COUNT];
+	ArgFrame  guiEventArgs[irr::gui::EGET_COUNT];
+	GUIEventQueue  eventQueue;
 
 public:
 	//! cstor
@@ -69,6 +106,15 @@ public:
 	//! Irrlicht event handling
 	virtual bool OnEvent(const irr::SEvent& event);
 
+	//! Runs the callbacks of the queued events. Call once per frame.
+	//! Stops once budget microseconds are spent (zero for no limit), leaving the rest to the next frame.
+	//! Returns the number of callbacks run.
+	irr::u32 pump( irr::u32  budget = 0 );
+
+	//! Queue of the coalesced events.
+	//! Give it to CuBridge::setEventQueue() so that GUI watchers follow the same policies.
+	GUIEventQueue& getEventQueue();
+
 protected:
 	//bool OnMouseInputEvent(const irr::SMouseInput& event);
 	//bool OnKeyInputEvent(const irr::SKeyInput& event);
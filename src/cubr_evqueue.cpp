@@ -0,0 +1,324 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_evqueue.h"
+#include "cubr_messagecodes.h"
+#include "cubr_irrevent_translate.h"
+#include "cubr_marshal.h"
+#include <chrono>
+
+namespace cubr {
+
+using namespace irr::gui;
+
+static irr::u64
+getMicroseconds() {
+	return (irr::u64) std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+EventCoalescing::Value
+getEventCoalescingFromString( const util::String&  name ) {
+	irr::u32  i = 0;
+	for (; EventCoalescingNames[i]; ++i) {
+		if ( name.equals(EventCoalescingNames[i]) )
+			return static_cast<EventCoalescing::Value>(i);
+	}
+	return EventCoalescing::Unknown;
+}
+
+GUIEventQueue::GUIEventQueue( Cu::Engine&  e )
+	: engine(e)
+	, overrides()
+	, pending()
+	, spareEvents()
+	, mergeSlots()
+	, mergeSlotsUsed(0)
+	, callerIdArg(REAL_NULL)
+	, elementIdArg(REAL_NULL)
+{
+	rebuildMergeSlots(16);
+	setPolicy( EventCoalescing::Immediate );
+	stats.depth = 0;
+	stats.peakDepth = 0;
+	stats.delivered = 0;
+	stats.carried = 0;
+	stats.pumpTime = 0;
+	stats.maxLatency = 0;
+	stats.averageLatency = 0;
+}
+
+GUIEventQueue::~GUIEventQueue() {
+	irr::u32  i = 0;
+	for (; i < pending.size(); ++i) {
+		if ( pending[i].callback )
+			pending[i].callback->deref();
+		pending[i].event->deref();
+	}
+	for (i=0; i < spareEvents.size(); ++i)
+		spareEvents[i]->deref();
+	if ( callerIdArg )
+		callerIdArg->deref();
+	if ( elementIdArg )
+		elementIdArg->deref();
+}
+
+void
+GUIEventQueue::setPolicy( EventCoalescing::Value  policy ) {
+	irr::u32  i = 0;
+	if ( policy == EventCoalescing::Unknown )
+		return;
+	for (; i < EGET_COUNT; ++i)
+		policies[i] = policy;
+}
+
+void
+GUIEventQueue::setPolicy( EGUI_EVENT_TYPE  type, EventCoalescing::Value  policy ) {
+	if ( type < EGET_COUNT && policy != EventCoalescing::Unknown )
+		policies[type] = policy;
+}
+
+void
+GUIEventQueue::setPolicy( EGUI_EVENT_TYPE  type, irr::s32  elementId, EventCoalescing::Value  policy ) {
+	PolicyOverride  po;
+	irr::u32  i = 0;
+
+	if ( type >= EGET_COUNT || policy == EventCoalescing::Unknown )
+		return;
+
+	for (; i < overrides.size(); ++i) {
+		if ( overrides[i].type == type && overrides[i].elementId == elementId ) {
+			overrides[i].policy = policy;
+			return;
+		}
+	}
+	po.type = type;
+	po.elementId = elementId;
+	po.policy = policy;
+	overrides.push_back(po);
+}
+
+EventCoalescing::Value
+GUIEventQueue::getPolicy( EGUI_EVENT_TYPE  type, irr::s32  elementId ) const {
+	irr::u32  i = 0;
+
+	if ( type >= EGET_COUNT )
+		return EventCoalescing::Immediate;
+
+	for (; i < overrides.size(); ++i) {
+		if ( overrides[i].type == type && overrides[i].elementId == elementId )
+			return overrides[i].policy;
+	}
+	return policies[type];
+}
+
+bool
+GUIEventQueue::enqueue( Cu::FunctionObject*  callback, const irr::SEvent::SGUIEvent&  event, bool  passArgs ) {
+	const EventCoalescing::Value  policy = getPolicy( event.EventType, event.Caller ? event.Caller->getID() : -1 );
+	Entry  entry;
+	Cu::Integer  count;
+	irr::s32  index;
+
+	if ( ! callback || policy == EventCoalescing::Immediate )
+		return false;
+
+	if ( policy != EventCoalescing::Deferred ) {
+		index = mergeSlots[ findMergeSlot(callback, event.Caller, event.EventType) ].index;
+		// Delivered entries have no callback, so they are never merged into
+		if ( index >= 0 && pending[index].callback == callback ) {
+			count = pending[index].event->getCount();
+			pending[index].event->set(event);
+			if ( policy == EventCoalescing::Count )
+				pending[index].event->setCount(count + 1);
+			return true;
+		}
+	}
+
+	if ( spareEvents.size() ) {
+		entry.event = spareEvents.getLast();
+		spareEvents.erase( spareEvents.size() - 1 );
+	} else {
+		entry.event = new GUIEvent();
+	}
+	entry.event->set(event);
+	entry.callback = callback;
+	entry.callback->ref();
+	entry.caller = event.Caller;
+	entry.queuedAt = getMicroseconds();
+	entry.passArgs = passArgs;
+	pending.push_back(entry);
+	indexPending( pending.size() - 1 );
+	if ( pending.size() > stats.peakDepth )
+		stats.peakDepth = pending.size();
+	return true;
+}
+
+irr::u32
+GUIEventQueue::pump( irr::u32  budget ) {
+	const irr::u64  start = getMicroseconds();
+	const irr::u32  count = pending.size(); // Events queued by the callbacks wait for the next pump
+	util::List<Cu::Object*>  args;
+	irr::u64  now = start;
+	irr::u64  latency;
+	irr::u64  totalLatency = 0;
+	Entry  entry;
+	irr::u32  i = 0;
+
+	stats.maxLatency = 0;
+	for (; i < count; ++i) {
+		if ( budget > 0 && i > 0 && now - start >= budget )
+			break;
+
+		// Copied since callbacks may queue events, moving the array
+		entry = pending[i];
+		pending[i].callback = REAL_NULL;
+		latency = now - entry.queuedAt;
+		totalLatency += latency;
+		if ( latency > stats.maxLatency )
+			stats.maxLatency = latency;
+
+		if ( entry.passArgs ) {
+			setIdArg( callerIdArg, entry.event->getCallerId() );
+			setIdArg( elementIdArg, entry.event->getElementId() );
+			args.clear();
+			args.push_back(callerIdArg);
+			args.push_back(elementIdArg);
+			args.push_back(entry.event);
+			engine.runFunctionObject(entry.callback, &args);
+		} else {
+			engine.runFunctionObject(entry.callback);
+		}
+		entry.callback->deref();
+		// Events kept by the callback must not change under it
+		if ( entry.event->getReferenceCount() == 1 )
+			spareEvents.push_back(entry.event);
+		else
+			entry.event->deref();
+		now = getMicroseconds();
+	}
+	if ( i > 0 ) {
+		pending.erase(0, (irr::s32)i);
+		rebuildMergeSlots( mergeSlots.size() );
+	}
+
+	stats.delivered += i;
+	stats.carried = count - i;
+	stats.pumpTime = now - start;
+	stats.averageLatency = i > 0 ? totalLatency / i : 0;
+	return i;
+}
+
+irr::u32
+GUIEventQueue::findMergeSlot( Cu::FunctionObject*  callback, const IGUIElement*  caller, EGUI_EVENT_TYPE  type ) const {
+	const irr::u32  mask = mergeSlots.size() - 1;
+	const size_t  hash = ( (size_t)callback >> 4 ) * 31 + ( (size_t)caller >> 4 ) * 17 + (size_t)type;
+	irr::u32  i = (irr::u32)( hash * 2654435761u ) & mask;
+
+	while ( mergeSlots[i].index >= 0
+		&& ! ( mergeSlots[i].callback == callback && mergeSlots[i].caller == caller && mergeSlots[i].type == type ) )
+	{
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+void
+GUIEventQueue::indexPending( irr::u32  index ) {
+	const Entry&  entry = pending[index];
+	irr::u32  slot;
+
+	// Kept at most half full so that probing stays short
+	if ( (mergeSlotsUsed + 1) * 2 > mergeSlots.size() ) {
+		// The entry is indexed with the others
+		rebuildMergeSlots( mergeSlots.size() * 2 );
+		return;
+	}
+	slot = findMergeSlot( entry.callback, entry.caller, entry.event->getEventType() );
+	if ( mergeSlots[slot].index < 0 ) {
+		mergeSlots[slot].callback = entry.callback;
+		mergeSlots[slot].caller = entry.caller;
+		mergeSlots[slot].type = entry.event->getEventType();
+		mergeSlots[slot].index = (irr::s32)index;
+		++mergeSlotsUsed;
+	} else if ( ! pending[ mergeSlots[slot].index ].callback ) {
+		mergeSlots[slot].index = (irr::s32)index;
+	}
+}
+
+void
+GUIEventQueue::rebuildMergeSlots( irr::u32  size ) {
+	MergeSlot  empty = { REAL_NULL, REAL_NULL, EGET_COUNT, -1 };
+	irr::u32  i = 0;
+
+	while ( pending.size() * 2 > size )
+		size *= 2;
+	mergeSlots.set_used(size);
+	for (; i < size; ++i)
+		mergeSlots[i] = empty;
+	mergeSlotsUsed = 0;
+	for (i=0; i < pending.size(); ++i) {
+		if ( pending[i].callback )
+			indexPending(i);
+	}
+}
+
+void
+GUIEventQueue::setIdArg( Cu::IntegerObject*&  arg, Cu::Integer  value ) {
+	if ( arg && arg->getIntegerValue() == value )
+		return;
+	if ( arg && arg->getReferenceCount() == 1 ) {
+		arg->setValue( Cu::IntegerObject(value) );
+		return;
+	}
+	if ( arg )
+		arg->deref();
+	arg = new Cu::IntegerObject(value);
+}
+
+irr::u32
+GUIEventQueue::getQueuedCount() const {
+	return pending.size();
+}
+
+void
+GUIEventQueue::getStats( Stats&  out ) const {
+	out = stats;
+	out.depth = pending.size();
+}
+
+Cu::ForeignFunc::Result
+GUIEventQueue::gui_coalesce(
+	Cu::FFIServices&  ffi,
+	Cu::StringObject&  eventName,
+	Cu::StringObject&  policyName,
+	Optional<Cu::NumericObject&>  elementId
+) {
+	const EGUI_EVENT_TYPE  type = getGUIEventTypeFromString( eventName.getString() );
+	const EventCoalescing::Value  policy = getEventCoalescingFromString( policyName.getString() );
+
+	if ( type == EGET_COUNT ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::GUIEventUnknownType );
+		return Cu::ForeignFunc::NONFATAL;
+	}
+	if ( policy == EventCoalescing::Unknown ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::EventCoalescingUnknown );
+		return Cu::ForeignFunc::NONFATAL;
+	}
+	if ( elementId.isSet() )
+		setPolicy( type, (irr::s32)elementId.get().getIntegerValue(), policy );
+	else
+		setPolicy( type, policy );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+GUIEventQueue::event_stats( Cu::FFIServices&  ffi, Optional<Cu::FunctionObject&>  storage ) {
+	if ( storage.isSet() ) {
+		Marshal<EventStats>::toCopper( EventStats::from(*this), &(storage.get()) );
+		ffi.setResult( &(storage.get()) );
+	} else {
+		ffi.setNewResult( Marshal<EventStats>::toCopper( EventStats::from(*this) ) );
+	}
+	return Cu::ForeignFunc::FINISHED;
+}
+
+}
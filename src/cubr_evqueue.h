@@ -0,0 +1,157 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_EVENT_QUEUE_H_
+#define _CUBR_EVENT_QUEUE_H_
+
+#include <IEventReceiver.h> // from Irrlicht
+#include <IGUIElement.h>
+#include <irrArray.h>
+#include <Copper.h>
+#include "cubr_guievent.h"
+#include "cubr_ffibind.h"
+
+namespace cubr {
+
+//! How often a callback is run for a GUI event
+struct EventCoalescing {
+enum Value {
+	Immediate, // Run the callback inside OnEvent(). Default.
+	Latest, // Queue the event. Newer events from the same element replace it until the queue is pumped.
+	Count, // As Latest, but the "count" member of the event is the number of events that were merged.
+	Deferred, // Queue every event. Nothing is merged.
+	Unknown, // NOT A POLICY. Returned for unknown names.
+};};
+
+const irr::c8* const EventCoalescingNames[] = {
+	"immediate",
+	"latest",
+	"count",
+	"deferred",
+	0
+};
+
+//! GUI Event Queue
+/*
+	Holds GUI events whose callbacks are not run immediately, so that a scrollbar drag or mouse hovering
+	runs the script once per frame rather than once per event.
+	The coalescing policy is set per event type and may be overridden for elements with a given ID.
+	Call pump() once per frame to run the callbacks of the queued events. Given a time budget, pump()
+	leaves the events it has no time for to the next frame, so that slow callbacks do not stall rendering.
+	Queued events are found for merging through a hash table keyed by callback, element and event type.
+	Event objects and the ID arguments are reused unless a callback keeps them.
+*/
+class GUIEventQueue {
+public:
+	struct Stats {
+		irr::u32  depth; // Events queued
+		irr::u32  peakDepth; // Most events queued at once
+		irr::u32  delivered; // Callbacks run by all pumps
+		irr::u32  carried; // Events left over by the last pump
+		irr::u64  pumpTime; // Microseconds spent by the last pump
+		irr::u64  maxLatency; // Longest wait (in microseconds) of the events run by the last pump
+		irr::u64  averageLatency; // Average wait (in microseconds) of the events run by the last pump
+	};
+
+private:
+	struct Entry {
+		Cu::FunctionObject*  callback; // Null once delivered
+		const irr::gui::IGUIElement*  caller; // Only compared. The element may be gone when the event is pumped.
+		GUIEvent*  event;
+		irr::u64  queuedAt; // Microseconds. Kept when newer events are merged.
+		bool  passArgs; // Run the callback with the caller ID, the element ID and the event
+	};
+
+	// Open addressing, linear probing. Rebuilt by pump() since it moves the pending entries.
+	struct MergeSlot {
+		Cu::FunctionObject*  callback;
+		const irr::gui::IGUIElement*  caller;
+		irr::gui::EGUI_EVENT_TYPE  type;
+		irr::s32  index; // Into pending. -1 if the slot is empty.
+	};
+
+	struct PolicyOverride {
+		irr::gui::EGUI_EVENT_TYPE  type;
+		irr::s32  elementId;
+		EventCoalescing::Value  policy;
+	};
+
+	Cu::Engine&  engine;
+	EventCoalescing::Value  policies[irr::gui::EGET_COUNT];
+	irr::core::array<PolicyOverride>  overrides;
+	irr::core::array<Entry>  pending;
+	irr::core::array<GUIEvent*>  spareEvents; // Reused for new entries
+	irr::core::array<MergeSlot>  mergeSlots; // Size is a power of two
+	irr::u32  mergeSlotsUsed;
+	Cu::IntegerObject*  callerIdArg;
+	Cu::IntegerObject*  elementIdArg;
+	Stats  stats;
+
+public:
+	GUIEventQueue( Cu::Engine& );
+
+	~GUIEventQueue();
+
+	//! Sets the policy for all event types
+	void
+	setPolicy( EventCoalescing::Value );
+
+	void
+	setPolicy( irr::gui::EGUI_EVENT_TYPE, EventCoalescing::Value );
+
+	//! Sets the policy for the events of the given type sent by elements with the given ID
+	void
+	setPolicy( irr::gui::EGUI_EVENT_TYPE, irr::s32  elementId, EventCoalescing::Value );
+
+	EventCoalescing::Value
+	getPolicy( irr::gui::EGUI_EVENT_TYPE, irr::s32  elementId ) const;
+
+	//! Queues the event for the callback unless its policy is immediate.
+	//! Returns true if the event was queued (or merged with a queued one) and false if the callback should be run now.
+	bool
+	enqueue( Cu::FunctionObject*  callback, const irr::SEvent::SGUIEvent&, bool  passArgs );
+
+	//! Runs the callbacks of the queued events, in the order they were queued, until the budget
+	//! (in microseconds, zero for no limit) is spent. At least one callback is run.
+	//! The remaining events and those queued by the callbacks wait for the next pump.
+	//! Returns the number of callbacks run.
+	irr::u32
+	pump( irr::u32  budget = 0 );
+
+	irr::u32
+	getQueuedCount() const;
+
+	void
+	getStats( Stats& ) const;
+
+	// gui_coalesce( event_type: policy: [element_id:] )
+	Cu::ForeignFunc::Result
+	gui_coalesce( Cu::FFIServices&, Cu::StringObject&, Cu::StringObject&, Optional<Cu::NumericObject&> );
+
+	// event_stats( [storage:] )
+	Cu::ForeignFunc::Result
+	event_stats( Cu::FFIServices&, Optional<Cu::FunctionObject&> );
+
+private:
+	//! Returns the slot holding the key or the empty slot where it would go
+	irr::u32
+	findMergeSlot( Cu::FunctionObject*, const irr::gui::IGUIElement*, irr::gui::EGUI_EVENT_TYPE ) const;
+
+	//! Makes the pending entry the one merged into for its key unless an undelivered entry already is
+	void
+	indexPending( irr::u32 );
+
+	//! Empties the table, resizing it to the given number of slots, and indexes the undelivered entries
+	void
+	rebuildMergeSlots( irr::u32  size );
+
+	//! Sets the argument to an integer with the value, changing it in place if only the queue holds it
+	static void
+	setIdArg( Cu::IntegerObject*&, Cu::Integer );
+};
+
+EventCoalescing::Value
+getEventCoalescingFromString( const util::String& );
+
+}
+
+#endif
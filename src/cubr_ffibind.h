@@ -0,0 +1,368 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_FFI_BIND_H_
+#define _CUBR_FFI_BIND_H_
+
+#include <Copper.h>
+
+namespace cubr {
+
+//! Optional argument
+/*
+	Wraps a reference to an argument that the script may leave out.
+	Optional arguments must come after all required ones.
+*/
+template<class T>
+class Optional;
+
+template<class T>
+class Optional<T&> {
+	T*  value;
+
+public:
+	Optional()
+		: value(REAL_NULL)
+	{}
+
+	explicit Optional( T&  v )
+		: value(&v)
+	{}
+
+	bool
+	isSet() const {
+		return notNull(value);
+	}
+
+	T&
+	get() const {
+		return *value;
+	}
+};
+
+//! FFI Argument traits
+/*
+	Describes how to check and unpack an argument of the given type.
+	The generic version is for cubr objects, which have a static getTypeAsCuType().
+	Checks compare the object type directly rather than calling FFIServices::demandArgType(),
+	which is only called to report an argument that failed the check.
+*/
+template<class T>
+struct FFIArg;
+
+template<class T>
+struct FFIArg<T&> {
+	enum { required = 1 };
+
+	static Cu::ObjectType::Value
+	type() {
+		return T::getTypeAsCuType();
+	}
+
+	static bool
+	check( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return ffi.arg(index).getType() == T::getTypeAsCuType();
+	}
+
+	static T&
+	get( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return (T&)ffi.arg(index);
+	}
+};
+
+template<>
+struct FFIArg<Cu::Object&> {
+	enum { required = 1 };
+
+	static Cu::ObjectType::Value
+	type() {
+		return Cu::ObjectType::Unknown;
+	}
+
+	static bool
+	check( Cu::FFIServices&, Cu::UInteger ) {
+		return true;
+	}
+
+	static Cu::Object&
+	get( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return ffi.arg(index);
+	}
+};
+
+template<>
+struct FFIArg<Cu::FunctionObject&> {
+	enum { required = 1 };
+
+	static Cu::ObjectType::Value
+	type() {
+		return Cu::ObjectType::Function;
+	}
+
+	static bool
+	check( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return ffi.arg(index).getType() == Cu::ObjectType::Function;
+	}
+
+	static Cu::FunctionObject&
+	get( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return (Cu::FunctionObject&)ffi.arg(index);
+	}
+};
+
+template<>
+struct FFIArg<Cu::BoolObject&> {
+	enum { required = 1 };
+
+	static Cu::ObjectType::Value
+	type() {
+		return Cu::ObjectType::Bool;
+	}
+
+	static bool
+	check( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return Cu::isBoolObject(ffi.arg(index));
+	}
+
+	static Cu::BoolObject&
+	get( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return (Cu::BoolObject&)ffi.arg(index);
+	}
+};
+
+template<>
+struct FFIArg<Cu::StringObject&> {
+	enum { required = 1 };
+
+	static Cu::ObjectType::Value
+	type() {
+		return Cu::ObjectType::String;
+	}
+
+	static bool
+	check( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return Cu::isStringObject(ffi.arg(index));
+	}
+
+	static Cu::StringObject&
+	get( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return (Cu::StringObject&)ffi.arg(index);
+	}
+};
+
+template<>
+struct FFIArg<Cu::NumericObject&> {
+	enum { required = 1 };
+
+	static Cu::ObjectType::Value
+	type() {
+		return Cu::ObjectType::Numeric;
+	}
+
+	static bool
+	check( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return Cu::isNumericObject(ffi.arg(index));
+	}
+
+	static Cu::NumericObject&
+	get( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return (Cu::NumericObject&)ffi.arg(index);
+	}
+};
+
+template<class T>
+struct FFIArg< Optional<T&> > {
+	enum { required = 0 };
+
+	static Cu::ObjectType::Value
+	type() {
+		return FFIArg<T&>::type();
+	}
+
+	static bool
+	check( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		return index >= ffi.getArgCount() || FFIArg<T&>::check(ffi, index);
+	}
+
+	static Optional<T&>
+	get( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+		if ( index < ffi.getArgCount() )
+			return Optional<T&>( FFIArg<T&>::get(ffi, index) );
+		return Optional<T&>();
+	}
+};
+
+//! Argument index list (std::index_sequence is not available in C++11)
+template<unsigned... I>
+struct FFIIndices {};
+
+template<unsigned N, unsigned... I>
+struct FFIMakeIndices : FFIMakeIndices<N-1, N-1, I...> {};
+
+template<unsigned... I>
+struct FFIMakeIndices<0, I...> {
+	typedef  FFIIndices<I...>  type;
+};
+
+template<class... Args>
+struct FFIRequiredCount;
+
+template<>
+struct FFIRequiredCount<> {
+	enum { value = 0 };
+};
+
+template<class First, class... Rest>
+struct FFIRequiredCount<First, Rest...> {
+	enum { value = FFIArg<First>::required + FFIRequiredCount<Rest...>::value };
+};
+
+//! FFI Signature
+/*
+	Checks the script arguments against the parameters Args of a bound function.
+	The first failed check is reported through FFIServices.
+*/
+template<class... Args>
+struct FFISignature {
+	static bool
+	check( Cu::FFIServices&  ffi ) {
+		const Cu::UInteger  count = ffi.getArgCount();
+		if ( count < (Cu::UInteger)FFIRequiredCount<Args...>::value || count > sizeof...(Args) ) {
+			ffi.demandArgCountRange( FFIRequiredCount<Args...>::value, sizeof...(Args) ); // Reports the error
+			return false;
+		}
+		return checkTypes( ffi, typename FFIMakeIndices<sizeof...(Args)>::type() );
+	}
+
+private:
+	template<unsigned... I>
+	static bool
+	checkTypes( Cu::FFIServices&  ffi, FFIIndices<I...> ) {
+		// The leading element keeps the arrays from being empty
+		const bool  passed[] = { true, FFIArg<Args>::check(ffi, I)... };
+		const Cu::ObjectType::Value  types[] = { Cu::ObjectType::Unknown, FFIArg<Args>::type()... };
+		Cu::UInteger  i = 1;
+		for (; i <= sizeof...(Args); ++i) {
+			if ( ! passed[i] ) {
+				ffi.demandArgType(i - 1, types[i]); // Reports the error
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+//! Bound Foreign Method
+/*
+	Foreign function that checks and unpacks the arguments for a method of the form:
+	ForeignFunc::Result Host::method( Cu::FFIServices&, Args... )
+	The argument checks are generated from Args, so the method only needs to handle valid arguments.
+	Create with bindFFI().
+*/
+template<class Host, class... Args>
+class BoundForeignMethod : public Cu::ForeignFunc {
+public:
+	typedef  Cu::ForeignFunc::Result (Host::*Method)( Cu::FFIServices&, Args... );
+
+private:
+	Host*  host;
+	Method  method;
+
+public:
+	BoundForeignMethod( Host*  h, Method  m )
+		: host(h)
+		, method(m)
+	{}
+
+	virtual Cu::ForeignFunc::Result
+	call( Cu::FFIServices&  ffi ) {
+		if ( ! FFISignature<Args...>::check(ffi) )
+			return Cu::ForeignFunc::NONFATAL;
+		return invoke( ffi, typename FFIMakeIndices<sizeof...(Args)>::type() );
+	}
+
+private:
+	template<unsigned... I>
+	Cu::ForeignFunc::Result
+	invoke( Cu::FFIServices&  ffi, FFIIndices<I...> ) {
+		return (host->*method)( ffi, FFIArg<Args>::get(ffi, I)... );
+	}
+};
+
+//! Bound Foreign Function
+/*
+	Same as BoundForeignMethod but for a free function of the form:
+	ForeignFunc::Result function( Cu::FFIServices&, Args... )
+	Create with bindFFI().
+*/
+template<class... Args>
+class BoundForeignFunc : public Cu::ForeignFunc {
+public:
+	typedef  Cu::ForeignFunc::Result (*Function)( Cu::FFIServices&, Args... );
+
+private:
+	Function  function;
+
+public:
+	BoundForeignFunc( Function  f )
+		: function(f)
+	{}
+
+	virtual Cu::ForeignFunc::Result
+	call( Cu::FFIServices&  ffi ) {
+		if ( ! FFISignature<Args...>::check(ffi) )
+			return Cu::ForeignFunc::NONFATAL;
+		return invoke( ffi, typename FFIMakeIndices<sizeof...(Args)>::type() );
+	}
+
+private:
+	template<unsigned... I>
+	Cu::ForeignFunc::Result
+	invoke( Cu::FFIServices&  ffi, FFIIndices<I...> ) {
+		return function( ffi, FFIArg<Args>::get(ffi, I)... );
+	}
+};
+
+//! Bind FFI
+/*
+	Adds the given method to the engine as a foreign function, checking and unpacking the arguments
+	according to the method's parameters.
+	Use in place of Cu::addForeignMethodInstance() for methods with a fixed list of arguments.
+	Example:
+		ForeignFunc::Result gui_visible( Cu::FFIServices&, GUIElement&, Optional<Cu::BoolObject&> );
+		bindFFI(engine, "gui_visible", this, &CuBridge::gui_visible);
+*/
+template<class Host, class... Args>
+void
+bindFFI(
+	Cu::Engine&  engine,
+	const util::String&  name,
+	Host*  host,
+	Cu::ForeignFunc::Result (Host::*method)( Cu::FFIServices&, Args... )
+) {
+	BoundForeignMethod<Host, Args...>*  f = new BoundForeignMethod<Host, Args...>(host, method);
+	engine.addForeignFunction(name, f);
+	f->deref();
+}
+
+//! Bind FFI for free functions
+/*
+	Same as the method version.
+	Example:
+		ForeignFunc::Result GetSpriteRect( Cu::FFIServices&, Sprite& );
+		bindFFI(engine, "sprite_rect", &GetSpriteRect);
+*/
+template<class... Args>
+void
+bindFFI(
+	Cu::Engine&  engine,
+	const util::String&  name,
+	Cu::ForeignFunc::Result (*function)( Cu::FFIServices&, Args... )
+) {
+	BoundForeignFunc<Args...>*  f = new BoundForeignFunc<Args...>(function);
+	engine.addForeignFunction(name, f);
+	f->deref();
+}
+
+}
+
+#endif
@@ -0,0 +1,420 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_geom.h"
+#include "cubr_messagecodes.h"
+#include <cstdio>
+
+namespace cubr {
+
+bool isRectObject( Cu::Object&  object ) {
+	return object.getType() == Rect::getTypeAsCuType();
+}
+
+bool isVector2Object( Cu::Object&  object ) {
+	return object.getType() == Vector2::getTypeAsCuType();
+}
+
+bool isDimension2Object( Cu::Object&  object ) {
+	return object.getType() == Dimension2::getTypeAsCuType();
+}
+
+//----- Rect
+
+Rect::Rect( const rect_t&  r )
+	: Cu::Object( Rect::getTypeAsCuType() )
+	, value(r)
+{}
+
+const rect_t&
+Rect::get() const {
+	return value;
+}
+
+void
+Rect::set( const rect_t&  r ) {
+	value = r;
+}
+
+Cu::Object*
+Rect::copy() {
+	return new Rect(value);
+}
+
+void
+Rect::writeToString(String& out) const {
+	char  buffer[80];
+	std::snprintf(buffer, 80, "{CuBridge Rect %d %d %d %d}",
+		value.UpperLeftCorner.X, value.UpperLeftCorner.Y, value.LowerRightCorner.X, value.LowerRightCorner.Y);
+	out = buffer;
+}
+
+const char*
+Rect::typeName() const {
+	return Rect::StaticTypeName();
+}
+
+bool
+Rect::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == Rect::getTypeAsCuType();
+}
+
+//----- Vector2
+
+Vector2::Vector2( const irr::core::vector2df&  v )
+	: Cu::Object( Vector2::getTypeAsCuType() )
+	, value(v)
+{}
+
+const irr::core::vector2df&
+Vector2::get() const {
+	return value;
+}
+
+void
+Vector2::set( const irr::core::vector2df&  v ) {
+	value = v;
+}
+
+Cu::Object*
+Vector2::copy() {
+	return new Vector2(value);
+}
+
+void
+Vector2::writeToString(String& out) const {
+	char  buffer[80];
+	std::snprintf(buffer, 80, "{CuBridge Vector2 %g %g}", value.X, value.Y);
+	out = buffer;
+}
+
+const char*
+Vector2::typeName() const {
+	return Vector2::StaticTypeName();
+}
+
+bool
+Vector2::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == Vector2::getTypeAsCuType();
+}
+
+//----- Dimension2
+
+Dimension2::Dimension2( const irr::core::dimension2du&  d )
+	: Cu::Object( Dimension2::getTypeAsCuType() )
+	, value(d)
+{}
+
+const irr::core::dimension2du&
+Dimension2::get() const {
+	return value;
+}
+
+void
+Dimension2::set( const irr::core::dimension2du&  d ) {
+	value = d;
+}
+
+Cu::Object*
+Dimension2::copy() {
+	return new Dimension2(value);
+}
+
+void
+Dimension2::writeToString(String& out) const {
+	char  buffer[80];
+	std::snprintf(buffer, 80, "{CuBridge Dimension2 %u %u}", value.Width, value.Height);
+	out = buffer;
+}
+
+const char*
+Dimension2::typeName() const {
+	return Dimension2::StaticTypeName();
+}
+
+bool
+Dimension2::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == Dimension2::getTypeAsCuType();
+}
+
+//----- FloatArray
+
+bool isFloatArrayObject( Cu::Object&  object ) {
+	return object.getType() == FloatArray::getTypeAsCuType();
+}
+
+FloatArray::FloatArray( irr::u32  size, const irr::f32*  initValues )
+	: Cu::Object( FloatArray::getTypeAsCuType() )
+	, count( size < (irr::u32)MAX_SIZE ? size : (irr::u32)MAX_SIZE )
+{
+	irr::u32  i = 0;
+	for (; i < (irr::u32)MAX_SIZE; ++i)
+		values[i] = ( initValues && i < count ) ? initValues[i] : 0.f;
+}
+
+irr::u32
+FloatArray::size() const {
+	return count;
+}
+
+irr::f32*
+FloatArray::data() {
+	return values;
+}
+
+const irr::f32*
+FloatArray::data() const {
+	return values;
+}
+
+Cu::Object*
+FloatArray::copy() {
+	return new FloatArray(count, values);
+}
+
+void
+FloatArray::writeToString(String& out) const {
+	char  buffer[40];
+	std::snprintf(buffer, 40, "{CuBridge FloatArray %u}", count);
+	out = buffer;
+}
+
+const char*
+FloatArray::typeName() const {
+	return FloatArray::StaticTypeName();
+}
+
+bool
+FloatArray::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == FloatArray::getTypeAsCuType();
+}
+
+//----- Foreign functions
+
+static irr::s32
+getIntArg( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+	return (irr::s32) ((Cu::NumericObject&)ffi.arg(index)).getIntegerValue();
+}
+
+static irr::f32
+getDecimalArg( Cu::FFIServices&  ffi, Cu::UInteger  index ) {
+	return (irr::f32) ((Cu::NumericObject&)ffi.arg(index)).getDecimalValue();
+}
+
+Cu::ForeignFunc::Result
+CreateRect( Cu::FFIServices&  ffi ) {
+	rect_t  r(0,0,0,0);
+	if ( ffi.getArgCount() > 0 ) {
+		if ( ! ffi.demandArgCount(4)
+			|| ! ffi.demandAllArgsType(Cu::ObjectType::Numeric)
+		) {
+			return Cu::ForeignFunc::NONFATAL;
+		}
+		r = rect_t( getIntArg(ffi,0), getIntArg(ffi,1), getIntArg(ffi,2), getIntArg(ffi,3) );
+	}
+	ffi.setNewResult( new Rect(r) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+CreateVector2( Cu::FFIServices&  ffi ) {
+	irr::core::vector2df  v(0,0);
+	if ( ffi.getArgCount() > 0 ) {
+		if ( ! ffi.demandArgCount(2)
+			|| ! ffi.demandAllArgsType(Cu::ObjectType::Numeric)
+		) {
+			return Cu::ForeignFunc::NONFATAL;
+		}
+		v.set( getDecimalArg(ffi,0), getDecimalArg(ffi,1) );
+	}
+	ffi.setNewResult( new Vector2(v) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+CreateDimension2( Cu::FFIServices&  ffi ) {
+	irr::core::dimension2du  d(0,0);
+	if ( ffi.getArgCount() > 0 ) {
+		if ( ! ffi.demandArgCount(2)
+			|| ! ffi.demandAllArgsType(Cu::ObjectType::Numeric)
+		) {
+			return Cu::ForeignFunc::NONFATAL;
+		}
+		d.set( (irr::u32)getIntArg(ffi,0), (irr::u32)getIntArg(ffi,1) );
+	}
+	ffi.setNewResult( new Dimension2(d) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+// Returns the integer component of the rectangle with the given name or null if there is none.
+static irr::s32*
+getRectComponent( rect_t&  r, const util::String&  member ) {
+	if ( member.equals("x") ) return &(r.UpperLeftCorner.X);
+	if ( member.equals("y") ) return &(r.UpperLeftCorner.Y);
+	if ( member.equals("x2") ) return &(r.LowerRightCorner.X);
+	if ( member.equals("y2") ) return &(r.LowerRightCorner.Y);
+	return 0;
+}
+
+Cu::ForeignFunc::Result
+GetGeometryMember( Cu::FFIServices&  ffi, Cu::Object&  object, Cu::StringObject&  memberName ) {
+	const util::String&  member = memberName.getString();
+
+	if ( isRectObject(object) ) {
+		rect_t  r = ((Rect&)object).get();
+		irr::s32*  component = getRectComponent(r, member);
+		if ( component ) {
+			ffi.setNewResult( new Cu::IntegerObject(*component) );
+			return Cu::ForeignFunc::FINISHED;
+		}
+		if ( member.equals("width") ) {
+			ffi.setNewResult( new Cu::IntegerObject(r.getWidth()) );
+			return Cu::ForeignFunc::FINISHED;
+		}
+		if ( member.equals("height") ) {
+			ffi.setNewResult( new Cu::IntegerObject(r.getHeight()) );
+			return Cu::ForeignFunc::FINISHED;
+		}
+	}
+	else if ( isVector2Object(object) ) {
+		const irr::core::vector2df&  v = ((Vector2&)object).get();
+		if ( member.equals("x") ) {
+			ffi.setNewResult( new Cu::DecimalNumObject(v.X) );
+			return Cu::ForeignFunc::FINISHED;
+		}
+		if ( member.equals("y") ) {
+			ffi.setNewResult( new Cu::DecimalNumObject(v.Y) );
+			return Cu::ForeignFunc::FINISHED;
+		}
+	}
+	else if ( isDimension2Object(object) ) {
+		const irr::core::dimension2du&  d = ((Dimension2&)object).get();
+		if ( member.equals("width") ) {
+			ffi.setNewResult( new Cu::IntegerObject(d.Width) );
+			return Cu::ForeignFunc::FINISHED;
+		}
+		if ( member.equals("height") ) {
+			ffi.setNewResult( new Cu::IntegerObject(d.Height) );
+			return Cu::ForeignFunc::FINISHED;
+		}
+	}
+	ffi.printCustomWarningCode( CuBridgeMessageCode::GeometryUnknownMember );
+	return Cu::ForeignFunc::NONFATAL;
+}
+
+Cu::ForeignFunc::Result
+SetGeometryMember( Cu::FFIServices&  ffi, Cu::Object&  object, Cu::StringObject&  memberName, Cu::NumericObject&  value ) {
+	const util::String&  member = memberName.getString();
+
+	if ( isRectObject(object) ) {
+		rect_t  r = ((Rect&)object).get();
+		irr::s32*  component = getRectComponent(r, member);
+		if ( component ) {
+			*component = (irr::s32) value.getIntegerValue();
+		}
+		else if ( member.equals("width") ) {
+			r.LowerRightCorner.X = r.UpperLeftCorner.X + (irr::s32) value.getIntegerValue();
+		}
+		else if ( member.equals("height") ) {
+			r.LowerRightCorner.Y = r.UpperLeftCorner.Y + (irr::s32) value.getIntegerValue();
+		}
+		else {
+			ffi.printCustomWarningCode( CuBridgeMessageCode::GeometryUnknownMember );
+			return Cu::ForeignFunc::NONFATAL;
+		}
+		((Rect&)object).set(r);
+		return Cu::ForeignFunc::FINISHED;
+	}
+	else if ( isVector2Object(object) ) {
+		irr::core::vector2df  v = ((Vector2&)object).get();
+		if ( member.equals("x") ) {
+			v.X = (irr::f32) value.getDecimalValue();
+		}
+		else if ( member.equals("y") ) {
+			v.Y = (irr::f32) value.getDecimalValue();
+		}
+		else {
+			ffi.printCustomWarningCode( CuBridgeMessageCode::GeometryUnknownMember );
+			return Cu::ForeignFunc::NONFATAL;
+		}
+		((Vector2&)object).set(v);
+		return Cu::ForeignFunc::FINISHED;
+	}
+	else if ( isDimension2Object(object) ) {
+		irr::core::dimension2du  d = ((Dimension2&)object).get();
+		if ( member.equals("width") ) {
+			d.Width = (irr::u32) value.getIntegerValue();
+		}
+		else if ( member.equals("height") ) {
+			d.Height = (irr::u32) value.getIntegerValue();
+		}
+		else {
+			ffi.printCustomWarningCode( CuBridgeMessageCode::GeometryUnknownMember );
+			return Cu::ForeignFunc::NONFATAL;
+		}
+		((Dimension2&)object).set(d);
+		return Cu::ForeignFunc::FINISHED;
+	}
+	ffi.printCustomWarningCode( CuBridgeMessageCode::GeometryUnknownMember );
+	return Cu::ForeignFunc::NONFATAL;
+}
+
+Cu::ForeignFunc::Result
+CreateFloatArray( Cu::FFIServices&  ffi ) {
+	if ( ! ffi.demandMinArgCount(1)
+		|| ! ffi.demandAllArgsType(Cu::ObjectType::Numeric)
+	) {
+		return Cu::ForeignFunc::NONFATAL;
+	}
+	FloatArray*  floats;
+	irr::s32  size;
+	Cu::UInteger  i;
+	if ( ffi.getArgCount() == 1 ) {
+		size = getIntArg(ffi,0);
+		floats = new FloatArray( size > 0 ? (irr::u32)size : 0 );
+	} else {
+		floats = new FloatArray( ffi.getArgCount() );
+		for (i = 0; i < floats->size(); ++i)
+			floats->data()[i] = getDecimalArg(ffi,i);
+	}
+	ffi.setNewResult(floats);
+	return Cu::ForeignFunc::FINISHED;
+}
+
+// Returns the index if it is within the float array, otherwise -1.
+static irr::s32
+getFloatArrayIndex( Cu::FFIServices&  ffi, FloatArray&  floats, Cu::NumericObject&  indexValue ) {
+	const irr::s32  index = (irr::s32) indexValue.getIntegerValue();
+	if ( index < 0 || (irr::u32)index >= floats.size() ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::FloatArrayIndexOutOfBounds );
+		return -1;
+	}
+	return index;
+}
+
+Cu::ForeignFunc::Result
+GetFloatArrayValue( Cu::FFIServices&  ffi, FloatArray&  floats, Cu::NumericObject&  indexValue ) {
+	const irr::s32  index = getFloatArrayIndex(ffi, floats, indexValue);
+	if ( index < 0 )
+		return Cu::ForeignFunc::NONFATAL;
+
+	ffi.setNewResult( new Cu::DecimalNumObject( floats.data()[index] ) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+SetFloatArrayValue( Cu::FFIServices&  ffi, FloatArray&  floats, Cu::NumericObject&  indexValue, Cu::NumericObject&  value ) {
+	const irr::s32  index = getFloatArrayIndex(ffi, floats, indexValue);
+	if ( index < 0 )
+		return Cu::ForeignFunc::NONFATAL;
+
+	floats.data()[index] = (irr::f32) value.getDecimalValue();
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+GetFloatArraySize( Cu::FFIServices&  ffi, FloatArray&  floats ) {
+	ffi.setNewResult( new Cu::IntegerObject( floats.size() ) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+} // cubr
@@ -0,0 +1,253 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_GEOMETRY_H_
+#define _CUBR_GEOMETRY_H_
+
+#include <rect.h> // from Irrlicht
+#include <vector2d.h>
+#include <dimension2d.h>
+#include <Copper.h>
+#include "cubr_base.h"
+
+namespace cubr {
+
+//! Geometry objects
+/*
+	Rectangles, vectors and dimensions stored inline as Copper objects.
+	The member-based form (a function with members x, y, x2, y2 and so on) needs a scope and a variable
+	for every number, which is wasteful when positions are read every frame.
+	These objects are accepted wherever the member-based form is, and they are produced by
+	AttributeSource and gui_position() when CuBridge::InitFlags::nativeGeometry is set.
+	Use geom_get() and geom_set() to access their values.
+*/
+
+bool
+isRectObject( Cu::Object& );
+
+bool
+isVector2Object( Cu::Object& );
+
+bool
+isDimension2Object( Cu::Object& );
+
+class Rect : public Cu::Object {
+
+	rect_t  value;
+
+public:
+	Rect( const rect_t& );
+
+	const rect_t&
+	get() const;
+
+	void
+	set( const rect_t& );
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubrrect";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::Rect );
+	}
+};
+
+class Vector2 : public Cu::Object {
+
+	irr::core::vector2df  value;
+
+public:
+	Vector2( const irr::core::vector2df& );
+
+	const irr::core::vector2df&
+	get() const;
+
+	void
+	set( const irr::core::vector2df& );
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubrvec2";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::Vector2 );
+	}
+};
+
+class Dimension2 : public Cu::Object {
+
+	irr::core::dimension2du  value;
+
+public:
+	Dimension2( const irr::core::dimension2du& );
+
+	const irr::core::dimension2du&
+	get() const;
+
+	void
+	set( const irr::core::dimension2du& );
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubrdim2";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::Dimension2 );
+	}
+};
+
+bool
+isFloatArrayObject( Cu::Object& );
+
+//! Float Array
+/*
+	A fixed-size array of up to 16 floats stored inline.
+	Used for attributes of many numbers (matrices, quaternions, boxes, planes, triangles and lines),
+	which would otherwise need a member function for every number.
+	Value order:
+	matrix - the 16 values in Irrlicht's order
+	quaternion - x, y, z, w
+	box - min x, y, z, max x, y, z
+	plane - normal x, y, z, d
+	triangle - a x, y, z, b x, y, z, c x, y, z
+	line - start x, y, [z,] end x, y, [z]
+*/
+class FloatArray : public Cu::Object {
+public:
+	enum { MAX_SIZE = 16 };
+
+private:
+	irr::f32  values[MAX_SIZE];
+	irr::u32  count;
+
+public:
+	//! Size is clamped to MAX_SIZE. Values are zero if none are given.
+	FloatArray( irr::u32  size, const irr::f32*  initValues = 0 );
+
+	irr::u32
+	size() const;
+
+	irr::f32*
+	data();
+
+	const irr::f32*
+	data() const;
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubrfloats";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::FloatArray );
+	}
+};
+
+// rect_create( [x, y, x2, y2] )
+Cu::ForeignFunc::Result
+CreateRect( Cu::FFIServices& );
+
+// vec2_create( [x, y] )
+Cu::ForeignFunc::Result
+CreateVector2( Cu::FFIServices& );
+
+// dim2_create( [width, height] )
+Cu::ForeignFunc::Result
+CreateDimension2( Cu::FFIServices& );
+
+// geom_get( geometry object, "member" )
+// Members are x, y, x2, y2, width and height for rectangles, x and y for vectors, and width and height for dimensions.
+Cu::ForeignFunc::Result
+GetGeometryMember( Cu::FFIServices&, Cu::Object&, Cu::StringObject& );
+
+// geom_set( geometry object, "member", value )
+// Setting the width or height of a rectangle moves its lower right corner.
+Cu::ForeignFunc::Result
+SetGeometryMember( Cu::FFIServices&, Cu::Object&, Cu::StringObject&, Cu::NumericObject& );
+
+// floats_create( size ) / floats_create( value, value, ... )
+Cu::ForeignFunc::Result
+CreateFloatArray( Cu::FFIServices& );
+
+// floats_get( float array, index )
+Cu::ForeignFunc::Result
+GetFloatArrayValue( Cu::FFIServices&, FloatArray&, Cu::NumericObject& );
+
+// floats_set( float array, index, value )
+Cu::ForeignFunc::Result
+SetFloatArrayValue( Cu::FFIServices&, FloatArray&, Cu::NumericObject&, Cu::NumericObject& );
+
+// floats_size( float array )
+Cu::ForeignFunc::Result
+GetFloatArraySize( Cu::FFIServices&, FloatArray& );
+
+} // cubr
+
+#endif
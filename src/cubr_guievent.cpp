@@ -0,0 +1,194 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_guievent.h"
+#include "cubr_messagecodes.h"
+#include "cubr_irrevent_translate.h"
+#include <IGUICheckBox.h>
+#include <IGUIComboBox.h>
+#include <IGUIContextMenu.h>
+#include <IGUIListBox.h>
+#include <IGUIScrollBar.h>
+#include <IGUISpinBox.h>
+#include <IGUITabControl.h>
+#include <IGUITable.h>
+#include <cstdio>
+
+namespace cubr {
+
+using namespace irr::gui;
+
+bool isGUIEventObject( Cu::Object&  object ) {
+	return object.getType() == GUIEvent::getTypeAsCuType();
+}
+
+GUIEvent::GUIEvent()
+	: Cu::Object( GUIEvent::getTypeAsCuType() )
+	, type(EGET_COUNT)
+	, callerId(-1)
+	, elementId(-1)
+	, value(-1)
+	, decimalValue(0)
+	, isDecimal(false)
+	, checked(false)
+	, count(1)
+{}
+
+void
+GUIEvent::set( const irr::SEvent::SGUIEvent&  event ) {
+	IGUIElement*  caller = event.Caller;
+	IGUIContextMenu*  menu;
+
+	type = event.EventType;
+	callerId = caller ? caller->getID() : -1;
+	elementId = event.Element ? event.Element->getID() : -1;
+	value = -1;
+	decimalValue = 0;
+	isDecimal = false;
+	checked = false;
+	count = 1;
+	if ( ! caller )
+		return;
+
+	// The element type is checked as well, since custom elements may send the same events
+	switch ( event.EventType ) {
+	case EGET_SCROLL_BAR_CHANGED:
+		if ( caller->getType() == EGUIET_SCROLL_BAR )
+			value = ((IGUIScrollBar*)caller)->getPos();
+		break;
+
+	case EGET_CHECKBOX_CHANGED:
+		if ( caller->getType() == EGUIET_CHECK_BOX )
+			checked = ((IGUICheckBox*)caller)->isChecked();
+		break;
+
+	case EGET_LISTBOX_CHANGED:
+	case EGET_LISTBOX_SELECTED_AGAIN:
+		if ( caller->getType() == EGUIET_LIST_BOX )
+			value = ((IGUIListBox*)caller)->getSelected();
+		break;
+
+	case EGET_COMBO_BOX_CHANGED:
+		if ( caller->getType() == EGUIET_COMBO_BOX )
+			value = ((IGUIComboBox*)caller)->getSelected();
+		break;
+
+	case EGET_TAB_CHANGED:
+		if ( caller->getType() == EGUIET_TAB_CONTROL )
+			value = ((IGUITabControl*)caller)->getActiveTab();
+		break;
+
+	case EGET_SPINBOX_CHANGED:
+		if ( caller->getType() == EGUIET_SPIN_BOX ) {
+			decimalValue = ((IGUISpinBox*)caller)->getValue();
+			isDecimal = true;
+		}
+		break;
+
+	case EGET_TABLE_CHANGED:
+	case EGET_TABLE_SELECTED_AGAIN:
+		if ( caller->getType() == EGUIET_TABLE )
+			value = ((IGUITable*)caller)->getSelected();
+		break;
+
+	case EGET_MENU_ITEM_SELECTED:
+		if ( caller->getType() == EGUIET_CONTEXT_MENU || caller->getType() == EGUIET_MENU ) {
+			menu = (IGUIContextMenu*)caller;
+			if ( menu->getSelectedItem() >= 0 )
+				value = menu->getItemCommandId( (irr::u32)menu->getSelectedItem() );
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+EGUI_EVENT_TYPE
+GUIEvent::getEventType() const {
+	return type;
+}
+
+Cu::Integer
+GUIEvent::getCallerId() const {
+	return callerId;
+}
+
+Cu::Integer
+GUIEvent::getElementId() const {
+	return elementId;
+}
+
+Cu::Integer
+GUIEvent::getCount() const {
+	return count;
+}
+
+void
+GUIEvent::setCount( Cu::Integer  c ) {
+	count = c;
+}
+
+Cu::Object*
+GUIEvent::createMember( const util::String&  member ) const {
+	if ( member.equals("caller") )
+		return new Cu::IntegerObject(callerId);
+	if ( member.equals("element") )
+		return new Cu::IntegerObject(elementId);
+	if ( member.equals("value") ) {
+		if ( isDecimal )
+			return new Cu::DecimalNumObject(decimalValue);
+		return new Cu::IntegerObject(value);
+	}
+	if ( member.equals("checked") )
+		return new Cu::BoolObject(checked);
+	if ( member.equals("count") )
+		return new Cu::IntegerObject(count);
+	if ( member.equals("type") )
+		return new Cu::StringObject( util::String( type < EGET_COUNT ? GUIEventTypeNames[type] : "" ) );
+	return REAL_NULL;
+}
+
+Cu::Object*
+GUIEvent::copy() {
+	GUIEvent*  e = new GUIEvent();
+	e->type = type;
+	e->callerId = callerId;
+	e->elementId = elementId;
+	e->value = value;
+	e->decimalValue = decimalValue;
+	e->isDecimal = isDecimal;
+	e->checked = checked;
+	e->count = count;
+	return e;
+}
+
+void
+GUIEvent::writeToString(String& out) const {
+	char  buffer[100];
+	std::snprintf(buffer, 100, "{CuBridge GUIEvent %s %ld}",
+		type < EGET_COUNT ? GUIEventTypeNames[type] : "none", (long)callerId);
+	out = buffer;
+}
+
+const char*
+GUIEvent::typeName() const {
+	return GUIEvent::StaticTypeName();
+}
+
+bool
+GUIEvent::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == GUIEvent::getTypeAsCuType();
+}
+
+Cu::ForeignFunc::Result
+GetGUIEventMember( Cu::FFIServices&  ffi, GUIEvent&  event, Cu::StringObject&  member ) {
+	Cu::Object*  result = event.createMember( member.getString() );
+	if ( ! result ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::GUIEventUnknownMember );
+		return Cu::ForeignFunc::NONFATAL;
+	}
+	ffi.setNewResult(result);
+	return Cu::ForeignFunc::FINISHED;
+}
+
+}
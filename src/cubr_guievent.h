@@ -0,0 +1,100 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_GUI_EVENT_H_
+#define _CUBR_GUI_EVENT_H_
+
+#include <IEventReceiver.h> // from Irrlicht
+#include <Copper.h>
+#include "cubr_base.h"
+
+namespace cubr {
+
+bool
+isGUIEventObject( Cu::Object& );
+
+//! GUI Event
+/*
+	The details of a GUI event, passed to event callbacks after the caller and element IDs
+	so that callbacks need not ask the element for its new state.
+	The value depends on the event type:
+	- scrollbar change: scrollbar position
+	- listbox change, listbox select again, combobox change, table change, table select again: selected index
+	- tab change: active tab index
+	- spinbox change: spinbox value (decimal)
+	- menu item select: command ID of the selected item
+	- others: -1
+	Checked is only set for checkbox change.
+	Count is the number of events merged into this one by a coalescing event queue (see cubr_evqueue.h), otherwise 1.
+	Event handlers reuse one GUIEvent per callback, so it is only valid during the callback. Copies keep the values.
+	Use event_get() to access the values.
+*/
+class GUIEvent : public Cu::Object {
+	irr::gui::EGUI_EVENT_TYPE  type;
+	Cu::Integer  callerId;
+	Cu::Integer  elementId;
+	Cu::Integer  value;
+	irr::f32  decimalValue;
+	bool  isDecimal;
+	bool  checked;
+	Cu::Integer  count;
+
+public:
+	GUIEvent();
+
+	//! Reads the values from the event and the element that sent it
+	void
+	set( const irr::SEvent::SGUIEvent& );
+
+	irr::gui::EGUI_EVENT_TYPE
+	getEventType() const;
+
+	Cu::Integer
+	getCallerId() const;
+
+	Cu::Integer
+	getElementId() const;
+
+	Cu::Integer
+	getCount() const;
+
+	void
+	setCount( Cu::Integer );
+
+	//! Returns a new Copper object for the given member ("caller", "element", "type", "value", "checked" or "count")
+	//! or null if there is no such member.
+	Cu::Object*
+	createMember( const util::String& ) const;
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubrguievent";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::GUIEvent );
+	}
+};
+
+// event_get( event: member_name: )
+Cu::ForeignFunc::Result
+GetGUIEventMember( Cu::FFIServices&, GUIEvent&, Cu::StringObject& );
+
+}
+
+#endif
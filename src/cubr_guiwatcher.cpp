@@ -1,6 +1,7 @@
 // Copyright 2018 Nicolaus Anderson
 
 #include "cubr_guiwatcher.h"
+#include "cubr_messagecodes.h"
 
 namespace cubr {
 
@@ -13,9 +14,22 @@ GUIWatcher::GUIWatcher(
 )
 	: gui_element_t(irr::gui::EGUIET_ELEMENT, aEnvironment, aParent, id, aPos)
 	, engine(aEngine)
-	, eventType(irr::gui::EGET_ELEMENT_FOCUS_LOST)
-	, callback(REAL_NULL)
-{}
+	, eventQueue(REAL_NULL)
+{
+	irr::u32  i = 0;
+	for (; i < irr::gui::EGET_COUNT; ++i)
+		callbacks[i] = REAL_NULL;
+}
+
+GUIWatcher::~GUIWatcher() {
+	irr::u32  i = 0;
+	for (; i < irr::gui::EGET_COUNT; ++i) {
+		if ( callbacks[i] ) {
+			callbacks[i]->disown(this);
+			callbacks[i]->deref();
+		}
+	}
+}
 
 bool
 GUIWatcher::bringToFront(irr::gui::IGUIElement* element) {
@@ -37,9 +51,11 @@ GUIWatcher::bringToFront(irr::gui::IGUIElement* element) {
 
 bool
 GUIWatcher::OnEvent(const irr::SEvent&  event) {
-	if ( event.EventType == irr::EET_GUI_EVENT ) {
-		if ( event.GUIEvent.EventType == eventType ) {
-			run();
+	if ( event.EventType == irr::EET_GUI_EVENT && event.GUIEvent.EventType < irr::gui::EGET_COUNT ) {
+		Cu::FunctionObject*  callback = callbacks[event.GUIEvent.EventType];
+		if ( callback ) {
+			if ( ! eventQueue || ! eventQueue->enqueue(callback, event.GUIEvent, false) )
+				run( event.GUIEvent.EventType );
 			// Do NOT return run()'s result. Do NOT block event-passing chain.
 		}
 	}
@@ -48,24 +64,43 @@ GUIWatcher::OnEvent(const irr::SEvent&  event) {
 
 void
 GUIWatcher::setCallback( irr::gui::EGUI_EVENT_TYPE  aEventType, Cu::FunctionObject*  aCallback ) {
-	if ( !aCallback ) return;
+	if ( aEventType >= irr::gui::EGET_COUNT ) return;
 
-	aCallback->ref();
-	if ( callback ) callback->deref();
-	callback = aCallback;
-	callback->changeOwnerTo(this);
-	eventType = aEventType;
+	Cu::FunctionObject*  oldCallback = callbacks[aEventType];
+	if ( aCallback ) {
+		aCallback->ref();
+		aCallback->changeOwnerTo(this);
+	}
+	callbacks[aEventType] = aCallback;
+	if ( oldCallback ) {
+		// The same function may still be the callback of other event types
+		if ( ! owns(oldCallback) )
+			oldCallback->disown(this);
+		oldCallback->deref();
+	}
+}
+
+void
+GUIWatcher::setEventQueue( GUIEventQueue*  queue ) {
+	eventQueue = queue;
 }
 
 bool
 GUIWatcher::owns( Cu::FunctionObject*  container ) const {
-	return notNull(callback) && callback == container;
+	irr::u32  i = 0;
+	if ( isNull(container) )
+		return false;
+	for (; i < irr::gui::EGET_COUNT; ++i) {
+		if ( callbacks[i] == container )
+			return true;
+	}
+	return false;
 }
 
 bool
-GUIWatcher::run() {
-	if ( callback && engine ) {
-		engine->runFunctionObject(callback);
+GUIWatcher::run( irr::gui::EGUI_EVENT_TYPE  type ) {
+	if ( type < irr::gui::EGET_COUNT && callbacks[type] && engine ) {
+		engine->runFunctionObject(callbacks[type]);
 		return true;
 	}
 	return false;
@@ -105,18 +140,36 @@ GUIWatcherObject::supportsInterface( Cu::ObjectType::Value  type ) const {
 
 Cu::ForeignFunc::Result
 setGUIWatcherCallback( Cu::FFIServices& ffi ) {
-	if ( ffi.demandArgCount(3)
-		&& ffi.demandArgType(0, GUIWatcherObject::getTypeAsCuType())
-		&& ffi.demandArgType(1, Cu::ObjectType::String)
-		&& ffi.demandArgType(2, Cu::ObjectType::Function) )
-	{
+	const Cu::UInteger  count = ffi.getArgCount();
+	Cu::UInteger  i;
+
+	// The watcher followed by pairs of event names and callbacks
+	if ( count < 3 || count % 2 == 0 ) {
+		ffi.demandArgCount( count < 3 ? 3 : count + 1 ); // Reports the error
+		return Cu::ForeignFunc::NONFATAL;
+	}
+	if ( ! ffi.demandArgType(0, GUIWatcherObject::getTypeAsCuType()) )
+		return Cu::ForeignFunc::NONFATAL;
+
+	// All of the pairs are checked first so that none are set if any are wrong
+	for ( i = 1; i < count; i += 2 ) {
+		if ( ! ffi.demandArgType(i, Cu::ObjectType::String)
+			|| ! ffi.demandArgType(i + 1, Cu::ObjectType::Function) )
+		{
+			return Cu::ForeignFunc::NONFATAL;
+		}
+		if ( getGUIEventTypeFromString( ((Cu::StringObject&)ffi.arg(i)).getString() ) == irr::gui::EGET_COUNT ) {
+			ffi.printCustomWarningCode( CuBridgeMessageCode::GUIEventUnknownType );
+			return Cu::ForeignFunc::NONFATAL;
+		}
+	}
+	for ( i = 1; i < count; i += 2 ) {
 		((GUIWatcherObject&)ffi.arg(0)).setCallback(
-			getGUIEventTypeFromString( ((Cu::StringObject&)ffi.arg(1)).getString() ),
-			(Cu::FunctionObject*)&(ffi.arg(2))
+			getGUIEventTypeFromString( ((Cu::StringObject&)ffi.arg(i)).getString() ),
+			(Cu::FunctionObject*)&(ffi.arg(i + 1))
 		);
-		return Cu::ForeignFunc::FINISHED;
 	}
-	return Cu::ForeignFunc::NONFATAL;
+	return Cu::ForeignFunc::FINISHED;
 }
 
 
@@ -6,14 +6,20 @@
 #include "cubr_defs.h"
 #include "cubr_base.h"
 #include "cubr_irrevent_translate.h"
+#include "cubr_evqueue.h"
 #include <IGUIElement.h> // For bringToFront
 
 namespace cubr {
 
+//! GUI Watcher
+/*
+	Runs a Copper callback when its children send a GUI event.
+	Each event type has its own callback, so one watcher is enough for all the events of an element.
+*/
 class GUIWatcher : public gui_element_t, public Cu::Owner {
 	Cu::Engine*  engine;
-	irr::gui::EGUI_EVENT_TYPE  eventType;
-	Cu::FunctionObject*  callback;
+	Cu::FunctionObject*  callbacks[irr::gui::EGET_COUNT];
+	GUIEventQueue*  eventQueue; // Optional. Used for coalescing events.
 
 public:
 /*
@@ -31,23 +37,33 @@ public:
 */
 	GUIWatcher( Cu::Engine*, gui_environment_t*, gui_element_t*, irr::core::recti, irr::s32 );
 
+	~GUIWatcher();
+
 	virtual bool
 	bringToFront(irr::gui::IGUIElement* element);
 
 	virtual bool
 	OnEvent(const irr::SEvent&  event);
 
+	//! Sets the callback for the given event type, replacing any previous one for that type.
+	//! A null callback removes it.
 	void
 	setCallback( irr::gui::EGUI_EVENT_TYPE, Cu::FunctionObject* );
 
+	//! Events whose coalescing policy is not immediate are queued here rather than run
+	void
+	setEventQueue( GUIEventQueue* );
+
 	virtual bool
 	owns( Cu::FunctionObject*  container ) const;
 
+	//! Runs the callback of the given event type. Returns false if there is none.
 	bool
-	run();
+	run( irr::gui::EGUI_EVENT_TYPE );
 
 };
 
+// gui_set_callback( watcher: event_type: callback: [event_type: callback: ...] )
 Cu::ForeignFunc::Result
 setGUIWatcherCallback( Cu::FFIServices& );
 
@@ -67,6 +83,13 @@ public:
 		}
 	}
 
+	void
+	setEventQueue( GUIEventQueue*  queue ) {
+		if ( watcher ) {
+			watcher->setEventQueue( queue );
+		}
+	}
+
 	static Cu::ObjectType::Value
 	getTypeAsCuType() {
 		return getCubrTypeAsCuType( CubrObjectType::GUIWatcher );
@@ -0,0 +1,109 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_hotattr.h"
+#include <IGUIButton.h> // from Irrlicht
+#include <IGUICheckBox.h>
+#include <IGUIComboBox.h>
+#include <IGUIEditBox.h>
+#include <IGUIListBox.h>
+#include <IGUIScrollBar.h>
+#include <IGUISpinBox.h>
+#include <IGUIStaticText.h>
+#include <IGUITabControl.h>
+
+namespace cubr {
+
+using namespace irr;
+using namespace irr::gui;
+
+static void
+getButtonHotAttributes( gui_element_t* e, io::IAttributes& out ) {
+	out.addBool("Pressed", static_cast<IGUIButton*>(e)->isPressed());
+}
+
+static void
+getCheckBoxHotAttributes( gui_element_t* e, io::IAttributes& out ) {
+	out.addBool("Checked", static_cast<IGUICheckBox*>(e)->isChecked());
+}
+
+static void
+getScrollBarHotAttributes( gui_element_t* e, io::IAttributes& out ) {
+	out.addInt("Value", static_cast<IGUIScrollBar*>(e)->getPos());
+}
+
+static void
+getTextHotAttributes( gui_element_t* e, io::IAttributes& out ) {
+	out.addString("Caption", e->getText());
+}
+
+static void
+getComboBoxHotAttributes( gui_element_t* e, io::IAttributes& out ) {
+	out.addInt("Selected", static_cast<IGUIComboBox*>(e)->getSelected());
+}
+
+static void
+getListBoxHotAttributes( gui_element_t* e, io::IAttributes& out ) {
+	out.addInt("Selected", static_cast<IGUIListBox*>(e)->getSelected());
+}
+
+static void
+getSpinBoxHotAttributes( gui_element_t* e, io::IAttributes& out ) {
+	out.addFloat("Value", static_cast<IGUISpinBox*>(e)->getValue());
+}
+
+static void
+getTabControlHotAttributes( gui_element_t* e, io::IAttributes& out ) {
+	out.addInt("ActiveTab", static_cast<IGUITabControl*>(e)->getActiveTab());
+}
+
+HotAttributeTable::HotAttributeTable()
+	: customTypes()
+{
+	u32  i = 0;
+	for (; i < (u32)EGUIET_COUNT; ++i)
+		builtinTypes[i] = 0;
+
+	builtinTypes[EGUIET_BUTTON] = &getButtonHotAttributes;
+	builtinTypes[EGUIET_CHECK_BOX] = &getCheckBoxHotAttributes;
+	builtinTypes[EGUIET_SCROLL_BAR] = &getScrollBarHotAttributes;
+	builtinTypes[EGUIET_EDIT_BOX] = &getTextHotAttributes;
+	builtinTypes[EGUIET_STATIC_TEXT] = &getTextHotAttributes;
+	builtinTypes[EGUIET_COMBO_BOX] = &getComboBoxHotAttributes;
+	builtinTypes[EGUIET_LIST_BOX] = &getListBoxHotAttributes;
+	builtinTypes[EGUIET_SPIN_BOX] = &getSpinBoxHotAttributes;
+	builtinTypes[EGUIET_TAB_CONTROL] = &getTabControlHotAttributes;
+}
+
+void
+HotAttributeTable::set( EGUI_ELEMENT_TYPE  type, HotAttributeGetter  getter ) {
+	if ( (u32)type < (u32)EGUIET_COUNT ) {
+		builtinTypes[type] = getter;
+		return;
+	}
+	u32  i = 0;
+	for (; i < customTypes.size(); ++i) {
+		if ( customTypes[i].type == (s32)type ) {
+			customTypes[i].getter = getter;
+			return;
+		}
+	}
+	CustomType  custom;
+	custom.type = (s32)type;
+	custom.getter = getter;
+	customTypes.push_back(custom);
+}
+
+HotAttributeGetter
+HotAttributeTable::find( EGUI_ELEMENT_TYPE  type ) const {
+	if ( (u32)type < (u32)EGUIET_COUNT )
+		return builtinTypes[type];
+
+	u32  i = 0;
+	for (; i < customTypes.size(); ++i) {
+		if ( customTypes[i].type == (s32)type )
+			return customTypes[i].getter;
+	}
+	return 0;
+}
+
+}
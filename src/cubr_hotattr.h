@@ -0,0 +1,54 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_HOT_ATTRIBUTES_H_
+#define _CUBR_HOT_ATTRIBUTES_H_
+
+#include <EGUIElementTypes.h> // from Irrlicht
+#include <IAttributes.h> // from Irrlicht
+#include <irrArray.h> // from Irrlicht
+#include "cubr_defs.h"
+
+namespace cubr {
+
+//! Hot Attribute Getter
+/*
+	Writes the commonly polled values of an element (such as the Checked state of a check box) to
+	the given attributes using the element's own getters.
+	Attribute names should match those used by the element's serializeAttributes() so that the
+	values can be passed back to gui_value() or gui_set().
+	The element is guaranteed to be of the type the getter was registered for.
+*/
+typedef void (*HotAttributeGetter)( gui_element_t*, irr::io::IAttributes& );
+
+//! Hot Attribute Table
+/*
+	Used by gui_value() to avoid serializing every attribute of an element when only a few are wanted.
+	Without this, stock Irrlicht returns all attributes (see EARWF_OFTEN_CHECKED_ATTRS in cubridge.cpp).
+	Element types without a getter are serialized in full.
+*/
+class HotAttributeTable {
+	struct CustomType {
+		irr::s32  type;
+		HotAttributeGetter  getter;
+	};
+
+	HotAttributeGetter  builtinTypes[irr::gui::EGUIET_COUNT];
+	irr::core::array<CustomType>  customTypes;
+
+public:
+	//! Creates the table with getters for the stock Irrlicht elements.
+	HotAttributeTable();
+
+	//! Sets the getter for the given element type, replacing any existing one.
+	// Pass null to have the element type serialized in full.
+	void
+	set( irr::gui::EGUI_ELEMENT_TYPE, HotAttributeGetter );
+
+	//! Returns the getter for the given element type or null if there is none.
+	HotAttributeGetter
+	find( irr::gui::EGUI_ELEMENT_TYPE ) const;
+};
+
+}
+
+#endif
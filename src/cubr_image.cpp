@@ -2,164 +2,710 @@
 
 #include "cubr_messagecodes.h"
 #include "cubr_image.h"
+#include "cubr_marshal.h"
+#include "cubr_geom.h"
+#include "cubr_pixfmt.h"
+#include "cubr_imgkern.h"
 #include <cstdio>
+#include <cstring>
 
 namespace cubr {
 
+//----- PixelBuffer
+
+bool isPixelBufferObject( Cu::Object&  object ) {
+	return object.getType() == PixelBuffer::getTypeAsCuType();
+}
+
+PixelBuffer::PixelBuffer( irr::u32  size, const irr::u32*  initPixels )
+	: Cu::Object( PixelBuffer::getTypeAsCuType() )
+	, pixels()
+{
+	resize(size);
+	if ( initPixels && size > 0 )
+		std::memcpy( pixels.pointer(), initPixels, size * sizeof(irr::u32) );
+}
+
+irr::u32
+PixelBuffer::size() const {
+	return pixels.size();
+}
+
+void
+PixelBuffer::resize( irr::u32  size ) {
+	irr::u32  i = pixels.size();
+	pixels.set_used(size); // Pixels are plain integers, so they need not be constructed
+	for (; i < size; ++i)
+		pixels[i] = 0;
+}
+
+irr::u32*
+PixelBuffer::data() {
+	return pixels.pointer();
+}
+
+const irr::u32*
+PixelBuffer::data() const {
+	return pixels.const_pointer();
+}
+
+Cu::Object*
+PixelBuffer::copy() {
+	return new PixelBuffer( pixels.size(), pixels.const_pointer() );
+}
+
+void
+PixelBuffer::writeToString(String& out) const {
+	char  buffer[40];
+	std::snprintf(buffer, 40, "{CuBridge PixelBuffer %u}", pixels.size());
+	out = buffer;
+}
+
+const char*
+PixelBuffer::typeName() const {
+	return PixelBuffer::StaticTypeName();
+}
+
+bool
+PixelBuffer::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == PixelBuffer::getTypeAsCuType();
+}
+
+//----- Foreign functions
+
+// Stores the result in the function object given as the optional argument, or in a new one.
+template<class S>
+static void
+setMarshalledResult( Cu::FFIServices&  ffi, Optional<Cu::FunctionObject&>  target, const S&  value ) {
+	if ( target.isSet() ) {
+		Marshal<S>::toCopper(value, &(target.get()));
+		ffi.setResult( &(target.get()) );
+	} else {
+		ffi.setNewResult( Marshal<S>::toCopper(value) );
+	}
+}
+
+static irr::s32
+getInt( Cu::NumericObject&  value ) {
+	return (irr::s32) value.getIntegerValue();
+}
+
 Cu::ForeignFunc::Result
-GetImageDimensions( Cu::FFIServices&  ffi ) {
-	if ( ! ffi.demandArgType(0, Image::getTypeAsCuType()) ) {
+GetImageDimensions( Cu::FFIServices&  ffi, Image&  image, Optional<Cu::FunctionObject&>  storage ) {
+	setMarshalledResult(ffi, storage, ImageSize::from( image.getSize() ));
+	return Cu::ForeignFunc::FINISHED;
+}
+
+// Returns true if x,y is inside the image or region view. Offset receives the position of the region.
+static bool
+isInImage( Image&  image, Cu::Integer  x, Cu::Integer  y, irr::core::vector2di&  offset ) {
+	const rect_t  area = image.getRegion();
+	offset = area.UpperLeftCorner;
+	return x >= 0 && y >= 0 && x < area.getWidth() && y < area.getHeight();
+}
+
+Cu::ForeignFunc::Result
+GetImagePixel(
+	Cu::FFIServices&  ffi,
+	Image&  image,
+	Cu::NumericObject&  xValue,
+	Cu::NumericObject&  yValue,
+	Optional<Cu::FunctionObject&>  storage
+) {
+	image_t*  img = image.getImage();
+	if ( ! img )
+		return Cu::ForeignFunc::NONFATAL;
+	Cu::Integer  x = xValue.getIntegerValue();
+	Cu::Integer  y = yValue.getIntegerValue();
+	irr::core::vector2di  offset;
+	irr::video::SColor  color(0);
+	if ( isInImage(image, x, y, offset) )
+		color = img->getPixel( irr::u32(x + offset.X), irr::u32(y + offset.Y) );
+
+	setMarshalledResult(ffi, storage, Color::from(color));
+	return Cu::ForeignFunc::FINISHED;
+}
+
+// Accepts an image, an x value, a y value, and a object with members red,green,blue,alpha to set a pixel color.
+Cu::ForeignFunc::Result
+SetImagePixel(
+	Cu::FFIServices&  ffi,
+	Image&  image,
+	Cu::NumericObject&  xValue,
+	Cu::NumericObject&  yValue,
+	Cu::FunctionObject&  colorValue
+) {
+	Cu::Integer  x = xValue.getIntegerValue();
+	Cu::Integer  y = yValue.getIntegerValue();
+	Color  color = { 255, 255, 255, 255 };
+
+	if ( ! Marshal<Color>::fromCopper( colorValue, color ) ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::ImageSetPixelMissingColor );
 		return Cu::ForeignFunc::NONFATAL;
 	}
 
-	image_t*  img = ((Image&)ffi.arg(0)).getImage();
-	irr::core::dimension2du  imgSize = irr::core::dimension2du(0,0);
-	if ( img ) {
-		imgSize = img->getDimension();
+	irr::core::vector2di  offset;
+	if ( ! isInImage(image, x, y, offset) )
+		return Cu::ForeignFunc::FINISHED;
+
+	image_t*  img = image.getWritableImage();
+	if ( ! img )
+		return Cu::ForeignFunc::NONFATAL;
+
+	img->setPixel( irr::u32(x + offset.X), irr::u32(y + offset.Y), color.toSColor() );
+	image.addDirtyRect( rect_t( (irr::s32)x, (irr::s32)y, (irr::s32)x + 1, (irr::s32)y + 1 ) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+CreatePixelBuffer( Cu::FFIServices&  ffi, Cu::NumericObject&  sizeValue ) {
+	const irr::s32  size = getInt(sizeValue);
+	ffi.setNewResult( new PixelBuffer( size > 0 ? (irr::u32)size : 0 ) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+// Returns the index if it is within the pixel buffer, otherwise -1.
+static irr::s32
+getPixelBufferIndex( Cu::FFIServices&  ffi, PixelBuffer&  buffer, Cu::NumericObject&  indexValue ) {
+	const irr::s32  index = getInt(indexValue);
+	if ( index < 0 || (irr::u32)index >= buffer.size() ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::PixelBufferIndexOutOfBounds );
+		return -1;
 	}
-	// Create a new Copper function with members width and height
-	Cu::FunctionObject*  funcObject = new Cu::FunctionObject();
-	Cu::Function*  func = REAL_NULL;
-	Cu::Variable*  var;
-	Cu::IntegerObject*  intObject;
-	// TODO: PROBLEM: The image width is an unsigned int. What if it's value is greater than int can hold?
+	return index;
+}
 
-	if ( funcObject->getFunction(func) ) {
-		// width
-		var = func->getPersistentScope().addVariable("width");
-		intObject = new Cu::IntegerObject(imgSize.Width);
-		var->setFuncReturn(intObject, false);
-		intObject->deref();
+bool
+getColorArg( Cu::FFIServices&  ffi, Cu::UInteger  index, irr::u32&  color ) {
+	if ( Cu::isNumericObject(ffi.arg(index)) ) {
+		color = (irr::u32) ((Cu::NumericObject&)ffi.arg(index)).getIntegerValue();
+		return true;
+	}
+	if ( ! ffi.demandArgType(index, Cu::ObjectType::Function) )
+		return false;
 
-		// height
-		var = func->getPersistentScope().addVariable("height");
-		intObject = new Cu::IntegerObject(imgSize.Height);
-		var->setFuncReturn(intObject, false);
-		intObject->deref();
+	Color  c = { 255, 255, 255, 255 };
+	if ( ! Marshal<Color>::fromCopper( (Cu::FunctionObject&)ffi.arg(index), c ) ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::ImageSetPixelMissingColor );
+		return false;
+	}
+	color = c.toSColor().color;
+	return true;
+}
 
-		ffi.setNewResult(funcObject);
+bool
+checkPackableImage( Cu::FFIServices&  ffi, Image&  image, bool  writing ) {
+	image_t*  img = image.getImage();
+	if ( ! img || ! isPackableColorFormat( img->getColorFormat() ) ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::ImageColorFormatNotSupported );
+		return false;
 	}
+	if ( writing )
+		image.getWritableImage();
+	return true;
+}
+
+Image*
+getPackableImageArg( Cu::FFIServices&  ffi, bool  writing, Cu::UInteger  index ) {
+	if ( ! ffi.demandArgType(index, Image::getTypeAsCuType()) )
+		return 0;
+
+	Image&  image = (Image&)ffi.arg(index);
+	return checkPackableImage(ffi, image, writing) ? &image : 0;
+}
+
+// Same as checkPackableImage() but also locks the pixels, which must be unlocked with Image::unlockPixels().
+static bool
+lockPackableImage( Cu::FFIServices&  ffi, Image&  image, bool  writing, PixelRect&  pixels ) {
+	return checkPackableImage(ffi, image, writing) && image.lockPixels(pixels, writing);
+}
 
+// Clips the span of count pixels starting at x on row y to the image of the given size.
+// Returns the number of pixels inside the image. Skipped receives the number of pixels cut from the start.
+static irr::u32
+clipSpan( const irr::core::dimension2du&  size, irr::s32&  x, irr::s32  y, irr::u32  count, irr::u32&  skipped ) {
+	skipped = 0;
+	if ( y < 0 || (irr::u32)y >= size.Height )
+		return 0;
+	if ( x < 0 ) {
+		if ( (irr::u32)(-x) >= count )
+			return 0;
+		skipped = (irr::u32)(-x);
+		count -= skipped;
+		x = 0;
+	}
+	if ( (irr::u32)x >= size.Width )
+		return 0;
+	if ( count > size.Width - (irr::u32)x )
+		count = size.Width - (irr::u32)x;
+	return count;
+}
+
+Cu::ForeignFunc::Result
+GetPixelBufferValue( Cu::FFIServices&  ffi, PixelBuffer&  buffer, Cu::NumericObject&  indexValue ) {
+	const irr::s32  index = getPixelBufferIndex(ffi, buffer, indexValue);
+	if ( index < 0 )
+		return Cu::ForeignFunc::NONFATAL;
+
+	ffi.setNewResult( new Cu::IntegerObject( (Cu::Integer) buffer.data()[index] ) );
 	return Cu::ForeignFunc::FINISHED;
 }
 
 Cu::ForeignFunc::Result
-GetImagePixel( Cu::FFIServices&  ffi ) {
-	if ( ! ffi.demandArgType(0, Image::getTypeAsCuType())
+SetPixelBufferValue( Cu::FFIServices&  ffi ) {
+	if ( ffi.getArgCount() != 3 && ! ffi.demandArgCount(6) )
+		return Cu::ForeignFunc::NONFATAL;
+
+	if ( ! ffi.demandArgType(0, PixelBuffer::getTypeAsCuType())
 		|| ! ffi.demandArgType(1, Cu::ObjectType::Numeric)
-		|| ! ffi.demandArgType(2, Cu::ObjectType::Numeric)
 	) {
 		return Cu::ForeignFunc::NONFATAL;
 	}
+	PixelBuffer&  buffer = (PixelBuffer&)ffi.arg(0);
+	const irr::s32  index = getPixelBufferIndex(ffi, buffer, (Cu::NumericObject&)ffi.arg(1));
+	if ( index < 0 )
+		return Cu::ForeignFunc::NONFATAL;
 
-	image_t*  img = ((Image&)ffi.arg(0)).getImage();
-	Cu::Integer  x = ((Cu::NumericObject&)ffi.arg(1)).getIntegerValue();
-	Cu::Integer  y = ((Cu::NumericObject&)ffi.arg(2)).getIntegerValue();
+	irr::u32  color;
+	if ( ffi.getArgCount() == 3 ) {
+		if ( ! getColorArg(ffi, 2, color) )
+			return Cu::ForeignFunc::NONFATAL;
+	} else {
+		if ( ! ffi.demandArgType(2, Cu::ObjectType::Numeric)
+			|| ! ffi.demandArgType(3, Cu::ObjectType::Numeric)
+			|| ! ffi.demandArgType(4, Cu::ObjectType::Numeric)
+			|| ! ffi.demandArgType(5, Cu::ObjectType::Numeric)
+		) {
+			return Cu::ForeignFunc::NONFATAL;
+		}
+		color = irr::video::SColor(
+			getInt((Cu::NumericObject&)ffi.arg(5)),
+			getInt((Cu::NumericObject&)ffi.arg(2)),
+			getInt((Cu::NumericObject&)ffi.arg(3)),
+			getInt((Cu::NumericObject&)ffi.arg(4))
+		).color;
+	}
+	buffer.data()[index] = color;
+	return Cu::ForeignFunc::FINISHED;
+}
 
-	irr::video::SColor  color = img->getPixel( irr::u32(x), irr::u32(y) );
+Cu::ForeignFunc::Result
+GetPixelBufferSize( Cu::FFIServices&  ffi, PixelBuffer&  buffer ) {
+	ffi.setNewResult( new Cu::IntegerObject( buffer.size() ) );
+	return Cu::ForeignFunc::FINISHED;
+}
 
-	// Create a new Copper function with members red, green, blue, and alpha
-	Cu::FunctionObject*  funcObject = new Cu::FunctionObject();
-	Cu::Function*  func = REAL_NULL;
-	Cu::Variable*  var;
-	Cu::IntegerObject*  intObject;
+Cu::ForeignFunc::Result
+GetImageRow( Cu::FFIServices&  ffi, Image&  image, Cu::NumericObject&  yValue, Optional<PixelBuffer&>  storage ) {
+	PixelRect  pixels;
+	if ( ! lockPackableImage(ffi, image, false, pixels) )
+		return Cu::ForeignFunc::NONFATAL;
 
-	if ( funcObject->getFunction(func) ) {
-		// red
-		var = func->getPersistentScope().addVariable("red");
-		intObject = new Cu::IntegerObject(color.getRed());
-		var->setFuncReturn(intObject, false);
-		intObject->deref();
+	const irr::u32  width = pixels.size.Width;
+	PixelBuffer*  buffer;
+	if ( storage.isSet() ) {
+		buffer = &(storage.get());
+		buffer->resize(width);
+		ffi.setResult(buffer);
+	} else {
+		buffer = new PixelBuffer(width);
+		ffi.setNewResult(buffer);
+	}
 
-		// green
-		var = func->getPersistentScope().addVariable("green");
-		intObject = new Cu::IntegerObject(color.getGreen());
-		var->setFuncReturn(intObject, false);
-		intObject->deref();
+	irr::s32  x = 0;
+	irr::u32  skipped;
+	const irr::s32  y = getInt(yValue);
+	const irr::u32  count = clipSpan(pixels.size, x, y, width, skipped);
+	if ( count > 0 )
+		readPixelsARGB( pixels.at(x, y), pixels.format, buffer->data(), count );
+	image.unlockPixels();
+	return Cu::ForeignFunc::FINISHED;
+}
 
-		// blue
-		var = func->getPersistentScope().addVariable("blue");
-		intObject = new Cu::IntegerObject(color.getBlue());
-		var->setFuncReturn(intObject, false);
-		intObject->deref();
+Cu::ForeignFunc::Result
+SetImageRow(
+	Cu::FFIServices&  ffi,
+	Image&  image,
+	Cu::NumericObject&  yValue,
+	PixelBuffer&  buffer,
+	Optional<Cu::NumericObject&>  xValue
+) {
+	PixelRect  pixels;
+	if ( ! lockPackableImage(ffi, image, true, pixels) )
+		return Cu::ForeignFunc::NONFATAL;
 
-		// alpha
-		var = func->getPersistentScope().addVariable("alpha");
-		intObject = new Cu::IntegerObject(color.getAlpha());
-		var->setFuncReturn(intObject, false);
-		intObject->deref();
+	irr::s32  x = xValue.isSet() ? getInt(xValue.get()) : 0;
+	irr::u32  skipped;
+	const irr::s32  y = getInt(yValue);
+	const irr::u32  count = clipSpan(pixels.size, x, y, buffer.size(), skipped);
+	if ( count > 0 ) {
+		writePixelsARGB( buffer.data() + skipped, pixels.format, pixels.at(x, y), count );
+		image.addDirtyRect( rect_t( x, y, x + (irr::s32)count, y + 1 ) );
+	}
+	image.unlockPixels();
+	return Cu::ForeignFunc::FINISHED;
+}
 
-		ffi.setNewResult(funcObject);
+// The color is read with getColorArg() since it may be an integer or an object.
+Cu::ForeignFunc::Result
+FillImageRect(
+	Cu::FFIServices&  ffi,
+	Image&  image,
+	Cu::NumericObject&  x1Value,
+	Cu::NumericObject&  y1Value,
+	Cu::NumericObject&  x2Value,
+	Cu::NumericObject&  y2Value,
+	Cu::Object&
+) {
+	irr::u32  color;
+	if ( ! getColorArg(ffi, 5, color) )
+		return Cu::ForeignFunc::NONFATAL;
+
+	const irr::s32  x1 = getInt(x1Value);
+	const irr::s32  y1 = getInt(y1Value);
+	const irr::s32  x2 = getInt(x2Value);
+	const irr::s32  y2 = getInt(y2Value);
+	if ( x2 <= x1 || y2 <= y1 )
+		return Cu::ForeignFunc::FINISHED;
+
+	PixelRect  pixels;
+	if ( ! lockPackableImage(ffi, image, true, pixels) )
+		return Cu::ForeignFunc::NONFATAL;
+
+	irr::s32  x;
+	irr::s32  y = y1;
+	irr::u32  count;
+	irr::u32  skipped;
+	for (; y < y2; ++y) {
+		x = x1;
+		count = clipSpan(pixels.size, x, y, (irr::u32)(x2 - x1), skipped);
+		if ( count > 0 )
+			fillPixelsARGB( color, pixels.format, pixels.at(x, y), count );
 	}
+	image.unlockPixels();
+	image.addDirtyRect( rect_t( x1, y1, x2, y2 ) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+WriteImageRect(
+	Cu::FFIServices&  ffi,
+	Image&  image,
+	Cu::NumericObject&  xValue,
+	Cu::NumericObject&  yValue,
+	Cu::NumericObject&  widthValue,
+	PixelBuffer&  buffer
+) {
+	const irr::s32  width = getInt(widthValue);
+	if ( width <= 0 )
+		return Cu::ForeignFunc::FINISHED;
 
+	PixelRect  pixels;
+	if ( ! lockPackableImage(ffi, image, true, pixels) )
+		return Cu::ForeignFunc::NONFATAL;
+
+	const irr::s32  x1 = getInt(xValue);
+	const irr::s32  y1 = getInt(yValue);
+	const irr::u32  rows = buffer.size() / (irr::u32)width;
+	irr::s32  x;
+	irr::u32  row = 0;
+	irr::u32  count;
+	irr::u32  skipped;
+	for (; row < rows; ++row) {
+		x = x1;
+		count = clipSpan(pixels.size, x, y1 + (irr::s32)row, (irr::u32)width, skipped);
+		if ( count > 0 )
+			writePixelsARGB( buffer.data() + row * (irr::u32)width + skipped, pixels.format,
+				pixels.at(x, y1 + (irr::s32)row), count );
+	}
+	image.unlockPixels();
+	image.addDirtyRect( rect_t( x1, y1, x1 + width, y1 + (irr::s32)rows ) );
 	return Cu::ForeignFunc::FINISHED;
 }
 
-// Accepts an image, an x value, a y value, and a object with members red,green,blue,alpha to set a pixel color.
+// The color is read with getColorArg() since it may be an integer or an object.
 Cu::ForeignFunc::Result
-SetImagePixel( Cu::FFIServices&  ffi ) {
-	if ( ! ffi.demandArgType(0, Image::getTypeAsCuType())
-		|| ! ffi.demandArgType(1, Cu::ObjectType::Numeric)
-		|| ! ffi.demandArgType(2, Cu::ObjectType::Numeric)
-		|| ! ffi.demandArgType(3, Cu::ObjectType::Function)
-	) {
+FillImage( Cu::FFIServices&  ffi, Image&  image, Cu::Object& ) {
+	irr::u32  color;
+	if ( ! getColorArg(ffi, 1, color) )
+		return Cu::ForeignFunc::NONFATAL;
+
+	PixelRect  pixels;
+	if ( ! lockPackableImage(ffi, image, true, pixels) )
 		return Cu::ForeignFunc::NONFATAL;
+
+	irr::u32  y = 0;
+	if ( pixels.pitch == pixels.size.Width * pixels.bytesPerPixel ) {
+		// Rows are contiguous
+		fillPixelsARGB( color, pixels.format, pixels.base, pixels.size.Width * pixels.size.Height );
+	} else {
+		for (; y < pixels.size.Height; ++y)
+			fillPixelsARGB( color, pixels.format, pixels.at(0, (irr::s32)y), pixels.size.Width );
 	}
+	image.unlockPixels();
+	image.setAllDirty();
+	return Cu::ForeignFunc::FINISHED;
+}
 
-	image_t*  img = ((Image&)ffi.arg(0)).getImage();
-	Cu::Integer  x = ((Cu::NumericObject&)ffi.arg(1)).getIntegerValue();
-	Cu::Integer  y = ((Cu::NumericObject&)ffi.arg(2)).getIntegerValue();
-	Cu::FunctionObject&  funcObject = (Cu::FunctionObject&)ffi.arg(3);
-	Cu::Function*  func = REAL_NULL;
-	Cu::Function*  member = REAL_NULL;
-	Cu::Variable*  var;
-	Cu::Object*  result;
-	irr::video::SColor  color = irr::video::SColor(255,255,255,255);
+//! Overlap of a source image drawn at x,y on a destination image
+struct ImageOverlap {
+	irr::s32  sourceX, sourceY;
+	irr::s32  destX, destY;
+	irr::s32  width, height;
 
-	if ( ! funcObject.getFunction(func) ) {
-		ffi.printCustomWarningCode( CuBridgeMessageCode::ImageSetPixelMissingColor );
+	ImageOverlap( const irr::core::dimension2du&  ds, const irr::core::dimension2du&  ss, irr::s32  x, irr::s32  y ) {
+		sourceX = x < 0 ? -x : 0;
+		sourceY = y < 0 ? -y : 0;
+		destX = x < 0 ? 0 : x;
+		destY = y < 0 ? 0 : y;
+		width = irr::core::min_( (irr::s32)ss.Width - sourceX, (irr::s32)ds.Width - destX );
+		height = irr::core::min_( (irr::s32)ss.Height - sourceY, (irr::s32)ds.Height - destY );
+	}
+
+	bool
+	empty() const {
+		return width <= 0 || height <= 0;
+	}
+};
+
+// Shared by image_blit() and image_blend()
+// A negative opacity copies instead of blending.
+static Cu::ForeignFunc::Result
+drawImage( Cu::FFIServices&  ffi, Image&  destImage, Image&  sourceImage, irr::s32  x, irr::s32  y, irr::s32  opacity ) {
+	// The destination is unshared before the source is read in case they are copies of each other
+	PixelRect  destPixels;
+	PixelRect  sourcePixels;
+	if ( ! lockPackableImage(ffi, destImage, true, destPixels) )
+		return Cu::ForeignFunc::NONFATAL;
+	if ( ! lockPackableImage(ffi, sourceImage, false, sourcePixels) ) {
+		destImage.unlockPixels();
 		return Cu::ForeignFunc::NONFATAL;
 	}
 
-	func->getPersistentScope().getVariable( "red", var );
-	member = var->getFunction(REAL_NULL); // Unable to report empty functions
-	if ( member->constantReturn ) {
-		if ( member->result.obtain( result ) ) {
-			if ( result->supportsInterface( Cu::ObjectType::Numeric ) )
-				color.setRed( ((Cu::NumericObject*)result)->getIntegerValue() );
-		}
+	const ImageOverlap  area( destPixels.size, sourcePixels.size, x, y );
+	const irr::video::ECOLOR_FORMAT  destFormat = destPixels.format;
+	const irr::video::ECOLOR_FORMAT  sourceFormat = sourcePixels.format;
+	// Region views of the same image share pixels too
+	const bool  sameImage = destImage.getImage() == sourceImage.getImage();
+	irr::core::array<irr::u32>  sourceRow;
+	irr::core::array<irr::u32>  destRow;
+	if ( ! area.empty() ) {
+		sourceRow.set_used( (irr::u32)area.width );
+		destRow.set_used( (irr::u32)area.width );
 	}
 
-	func->getPersistentScope().getVariable( "green", var );
-	member = var->getFunction(REAL_NULL); // Unable to report empty functions
-	if ( member->constantReturn ) {
-		if ( member->result.obtain( result ) ) {
-			if ( result->supportsInterface( Cu::ObjectType::Numeric ) )
-				color.setGreen( ((Cu::NumericObject*)result)->getIntegerValue() );
+	// When drawing an image onto itself, the rows are visited in the order that reads each row before it is written
+	const bool  reverse = sameImage && ! area.empty()
+		&& destPixels.at(area.destX, area.destY) > sourcePixels.at(area.sourceX, area.sourceY);
+	irr::s32  r = 0;
+	irr::s32  row;
+	irr::u8*  d;
+	const irr::u8*  s;
+	for (; r < area.height; ++r) {
+		row = reverse ? area.height - 1 - r : r;
+		d = destPixels.at(area.destX, area.destY + row);
+		s = sourcePixels.at(area.sourceX, area.sourceY + row);
+
+		if ( opacity < 0 ) {
+			if ( destFormat == sourceFormat ) {
+				std::memmove( d, s, (irr::u32)area.width * destPixels.bytesPerPixel );
+			} else {
+				readPixelsARGB( s, sourceFormat, sourceRow.pointer(), (irr::u32)area.width );
+				writePixelsARGB( sourceRow.pointer(), destFormat, d, (irr::u32)area.width );
+			}
+		} else if ( destFormat == irr::video::ECF_A8R8G8B8 && sourceFormat == irr::video::ECF_A8R8G8B8 && ! sameImage ) {
+			blendSpanARGB( (irr::u32*)d, (const irr::u32*)s, (irr::u32)area.width, (irr::u32)opacity );
+		} else {
+			readPixelsARGB( s, sourceFormat, sourceRow.pointer(), (irr::u32)area.width );
+			readPixelsARGB( d, destFormat, destRow.pointer(), (irr::u32)area.width );
+			blendSpanARGB( destRow.pointer(), sourceRow.pointer(), (irr::u32)area.width, (irr::u32)opacity );
+			writePixelsARGB( destRow.pointer(), destFormat, d, (irr::u32)area.width );
 		}
 	}
 
-	func->getPersistentScope().getVariable( "blue", var );
-	member = var->getFunction(REAL_NULL); // Unable to report empty functions
-	if ( member->constantReturn ) {
-		if ( member->result.obtain( result ) ) {
-			if ( result->supportsInterface( Cu::ObjectType::Numeric ) )
-				color.setBlue( ((Cu::NumericObject*)result)->getIntegerValue() );
+	sourceImage.unlockPixels();
+	destImage.unlockPixels();
+	if ( ! area.empty() )
+		destImage.addDirtyRect( rect_t( area.destX, area.destY, area.destX + area.width, area.destY + area.height ) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+BlitImage(
+	Cu::FFIServices&  ffi,
+	Image&  destination,
+	Image&  source,
+	Cu::NumericObject&  x,
+	Cu::NumericObject&  y
+) {
+	return drawImage(ffi, destination, source, getInt(x), getInt(y), -1);
+}
+
+Cu::ForeignFunc::Result
+BlendImage(
+	Cu::FFIServices&  ffi,
+	Image&  destination,
+	Image&  source,
+	Cu::NumericObject&  x,
+	Cu::NumericObject&  y,
+	Optional<Cu::NumericObject&>  opacityValue
+) {
+	irr::s32  opacity = opacityValue.isSet() ? getInt(opacityValue.get()) : 255;
+	opacity = irr::core::clamp(opacity, 0, 255);
+	return drawImage(ffi, destination, source, getInt(x), getInt(y), opacity);
+}
+
+Cu::ForeignFunc::Result
+PremultiplyImage( Cu::FFIServices&  ffi, Image&  image ) {
+	if ( ! checkPackableImage(ffi, image, false) )
+		return Cu::ForeignFunc::NONFATAL;
+
+	const irr::video::ECOLOR_FORMAT  format = image.getImage()->getColorFormat();
+	if ( format == irr::video::ECF_R8G8B8 || format == irr::video::ECF_R5G6B5 )
+		return Cu::ForeignFunc::FINISHED; // Always opaque
+
+	PixelRect  pixels;
+	if ( ! image.lockPixels(pixels, true) )
+		return Cu::ForeignFunc::NONFATAL;
+
+	const irr::core::dimension2du  size = pixels.size;
+	irr::core::array<irr::u32>  row;
+	irr::u8*  p;
+	irr::u32  y = 0;
+	if ( format != irr::video::ECF_A8R8G8B8 )
+		row.set_used(size.Width);
+	for (; y < size.Height; ++y) {
+		p = pixels.at(0, (irr::s32)y);
+		if ( format == irr::video::ECF_A8R8G8B8 ) {
+			premultiplySpanARGB( (irr::u32*)p, size.Width );
+		} else {
+			readPixelsARGB( p, format, row.pointer(), size.Width );
+			premultiplySpanARGB( row.pointer(), size.Width );
+			writePixelsARGB( row.pointer(), format, p, size.Width );
 		}
 	}
+	image.unlockPixels();
+	image.setAllDirty();
+	return Cu::ForeignFunc::FINISHED;
+}
 
-	func->getPersistentScope().getVariable( "alpha", var );
-	member = var->getFunction(REAL_NULL); // Unable to report empty functions
-	if ( member->constantReturn ) {
-		if ( member->result.obtain( result ) ) {
-			if ( result->supportsInterface( Cu::ObjectType::Numeric ) )
-				color.setAlpha( ((Cu::NumericObject*)result)->getIntegerValue() );
-		}
+bool
+getRectArg( Cu::FFIServices&  ffi, Cu::UInteger  index, rect_t&  out ) {
+	if ( isRectObject(ffi.arg(index)) ) {
+		out = ((Rect&)ffi.arg(index)).get();
+		return true;
+	}
+	if ( ! ffi.demandArgType(index, Cu::ObjectType::Function) )
+		return false;
+	RectI  r = { 0, 0, 0, 0 };
+	if ( ! Marshal<RectI>::fromCopper( (Cu::FunctionObject&)ffi.arg(index), r ) ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::GeometryUnknownMember );
+		return false;
 	}
+	out = r.toRect();
+	return true;
+}
 
-	img->setPixel( irr::u32(x), irr::u32(y), color );
+// The rectangle is read with getRectArg() since it may be a cubrrect or an object.
+Cu::ForeignFunc::Result
+CreateImageView( Cu::FFIServices&  ffi, Image&  image, Cu::Object& ) {
+	rect_t  area;
+	if ( ! getRectArg(ffi, 1, area) )
+		return Cu::ForeignFunc::NONFATAL;
 
+	ffi.setNewResult( new Image( image, area ) );
 	return Cu::ForeignFunc::FINISHED;
 }
 
+// The rectangle is read with getRectArg() since it may be a cubrrect or an object.
+Cu::ForeignFunc::Result
+UpdateTexture( Cu::FFIServices&  ffi, Texture&  texture, Image&  image, Optional<Cu::Object&>  rect ) {
+	texture_t*  tex = texture.getTexture();
+	if ( ! checkPackableImage(ffi, image, false) || ! tex )
+		return Cu::ForeignFunc::NONFATAL;
+
+	if ( texture.isLocked() ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::TextureLockFailed );
+		return Cu::ForeignFunc::NONFATAL;
+	}
+
+	rect_t  area = image.getDirtyRect();
+	if ( rect.isSet() && ! getRectArg(ffi, 2, area) )
+		return Cu::ForeignFunc::NONFATAL;
+
+	const irr::core::dimension2du  size = image.getSize();
+	if ( tex->getSize() != size ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::TextureSizeMismatch );
+		return Cu::ForeignFunc::NONFATAL;
+	}
+	const irr::video::ECOLOR_FORMAT  texFormat = tex->getColorFormat();
+	if ( ! isPackableColorFormat(texFormat) ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::ImageColorFormatNotSupported );
+		return Cu::ForeignFunc::NONFATAL;
+	}
+
+	area.clipAgainst( rect_t( irr::core::vector2di(0,0), size ) );
+	if ( area.getWidth() <= 0 || area.getHeight() <= 0 )
+		return Cu::ForeignFunc::FINISHED;
+
+	// Read-write since some drivers do not read back the texture when locked write-only,
+	// which would lose the pixels outside the area.
+	irr::u8*  texBase = (irr::u8*)tex->lock( irr::video::ETLM_READ_WRITE );
+	if ( ! texBase )
+		return Cu::ForeignFunc::FINISHED;
+
+	PixelRect  pixels;
+	image.lockPixels(pixels, false);
+	const irr::u32  width = (irr::u32)area.getWidth();
+	const irr::u32  texBytesPerPixel = irr::video::IImage::getBitsPerPixelFromFormat(texFormat) / 8;
+	irr::core::array<irr::u32>  row;
+	irr::s32  y = area.UpperLeftCorner.Y;
+	const irr::u8*  s;
+	irr::u8*  d;
+	row.set_used(width);
+	for (; y < area.LowerRightCorner.Y; ++y) {
+		s = pixels.at(area.UpperLeftCorner.X, y);
+		d = texBase + (irr::u32)y * tex->getPitch() + (irr::u32)area.UpperLeftCorner.X * texBytesPerPixel;
+		if ( pixels.format == texFormat ) {
+			std::memcpy( d, s, width * texBytesPerPixel );
+		} else {
+			readPixelsARGB( s, pixels.format, row.pointer(), width );
+			writePixelsARGB( row.pointer(), texFormat, d, width );
+		}
+	}
+	image.unlockPixels();
+	tex->unlock();
+	// Cleared only once copied, so that a failed lock leaves the changes for the next update.
+	// An explicit rectangle leaves the rest of the dirty region for the next update.
+	if ( ! rect.isSet() )
+		image.clearDirty();
+	if ( tex->hasMipMaps() )
+		tex->regenerateMipMapLevels();
+	return Cu::ForeignFunc::FINISHED;
+}
+
+image_t*
+createImageCopy( Image&  source, irr::video::ECOLOR_FORMAT  format ) {
+	PixelRect  pixels;
+	if ( ! source.lockPixels(pixels, false) )
+		return 0;
+
+	image_t*  destination = source.getVideoDriver()->createImage( format, pixels.size );
+	if ( isPackableColorFormat(pixels.format) && isPackableColorFormat(format) ) {
+		irr::u8*  d = (irr::u8*)destination->lock();
+		irr::core::array<irr::u32>  row;
+		irr::u32  y = 0;
+		row.set_used(pixels.size.Width);
+		for (; y < pixels.size.Height; ++y) {
+			readPixelsARGB( pixels.at(0, (irr::s32)y), pixels.format, row.pointer(), pixels.size.Width );
+			writePixelsARGB( row.pointer(), format, d + y * destination->getPitch(), pixels.size.Width );
+		}
+		destination->unlock();
+	} else {
+		source.getImage()->copyTo( destination, irr::core::vector2di(0,0), source.getRegion() );
+	}
+	source.unlockPixels();
+	return destination;
+}
+
 } // namespace cubr
@@ -8,21 +8,175 @@ Functions for getting and setting pixels.
 #define CUBR_IMAGE_H
 
 #include <Copper.h>
+#include <irrArray.h> // from Irrlicht
 #include "cubr_base.h"
+#include "cubr_ffibind.h"
 
 namespace cubr {
 
+bool
+isPixelBufferObject( Cu::Object& );
+
+//! Pixel Buffer
+/*
+	A list of pixels packed as A8R8G8B8 integers (the layout of SColor::color).
+	Used for moving many pixels between Copper and an image in one call.
+*/
+class PixelBuffer : public Cu::Object {
+	irr::core::array<irr::u32>  pixels;
+
+public:
+	//! New pixels are zero if none are given.
+	PixelBuffer( irr::u32  size, const irr::u32*  initPixels = 0 );
+
+	irr::u32
+	size() const;
+
+	//! New pixels are zero.
+	void
+	resize( irr::u32 );
+
+	irr::u32*
+	data();
+
+	const irr::u32*
+	data() const;
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubrpixels";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::PixelBuffer );
+	}
+};
+
 // Accepts an image and returns an object with members width,height.
+// If a function object is given after the image, the members are stored in it and it is returned.
 Cu::ForeignFunc::Result
-GetImageDimensions( Cu::FFIServices& );
+GetImageDimensions( Cu::FFIServices&, Image&, Optional<Cu::FunctionObject&> );
 
-// Accepts an image and returns an object with members red,green,blue,alpha.
+// Accepts an image, an x value, and a y value, and returns an object with members red,green,blue,alpha.
+// If a function object is given after the y value, the members are stored in it and it is returned.
 Cu::ForeignFunc::Result
-GetImagePixel( Cu::FFIServices& );
+GetImagePixel( Cu::FFIServices&, Image&, Cu::NumericObject&, Cu::NumericObject&, Optional<Cu::FunctionObject&> );
 
 // Accepts an image, an x value, a y value, and a object with members red,green,blue,alpha to set a pixel color.
 Cu::ForeignFunc::Result
-SetImagePixel( Cu::FFIServices& );
+SetImagePixel( Cu::FFIServices&, Image&, Cu::NumericObject&, Cu::NumericObject&, Cu::FunctionObject& );
+
+//! Reads the color at the given arg, which is an A8R8G8B8 integer or an object with members red,green,blue,alpha.
+// Missing members are 255. Prints a warning and returns false if the arg is neither.
+bool
+getColorArg( Cu::FFIServices&, Cu::UInteger  index, irr::u32&  color );
+
+//! Returns true if the color format of the image can be used by the bulk pixel functions, otherwise prints a warning.
+// When writing, the image is unshared first (see Image::getWritableImage()).
+bool
+checkPackableImage( Cu::FFIServices&, Image&, bool  writing );
+
+//! Returns the image at the given arg if it passes checkPackableImage(), otherwise null.
+Image*
+getPackableImageArg( Cu::FFIServices&, bool  writing, Cu::UInteger  index = 0 );
+
+// pixels_create( size )
+// Returns a pixel buffer of the given size with all pixels zero.
+Cu::ForeignFunc::Result
+CreatePixelBuffer( Cu::FFIServices&, Cu::NumericObject& );
+
+// pixels_get( buffer, index )
+// Returns the pixel as an A8R8G8B8 integer.
+Cu::ForeignFunc::Result
+GetPixelBufferValue( Cu::FFIServices&, PixelBuffer&, Cu::NumericObject& );
+
+// pixels_set( buffer, index, color ) / pixels_set( buffer, index, red, green, blue, alpha )
+// Color is an A8R8G8B8 integer or an object with members red,green,blue,alpha.
+Cu::ForeignFunc::Result
+SetPixelBufferValue( Cu::FFIServices& );
+
+// pixels_size( buffer )
+Cu::ForeignFunc::Result
+GetPixelBufferSize( Cu::FFIServices&, PixelBuffer& );
+
+// image_get_row( image, y [, buffer] )
+// Returns the row of the image as a pixel buffer. If a buffer is given, it is resized to the row and returned.
+Cu::ForeignFunc::Result
+GetImageRow( Cu::FFIServices&, Image&, Cu::NumericObject&, Optional<PixelBuffer&> );
+
+// image_set_row( image, y, buffer [, x] )
+// Writes the buffer to the row starting at x (default 0). Pixels outside the image are skipped.
+Cu::ForeignFunc::Result
+SetImageRow( Cu::FFIServices&, Image&, Cu::NumericObject&, PixelBuffer&, Optional<Cu::NumericObject&> );
+
+// image_fill_rect( image, x, y, x2, y2, color )
+// Fills the rectangle (not including x2 and y2) with the color, clipped to the image.
+// Color is an A8R8G8B8 integer or an object with members red,green,blue,alpha.
+Cu::ForeignFunc::Result
+FillImageRect( Cu::FFIServices&, Image&, Cu::NumericObject&, Cu::NumericObject&, Cu::NumericObject&, Cu::NumericObject&, Cu::Object& );
+
+// image_write_rect( image, x, y, width, buffer )
+// Writes the buffer as rows of the given width starting at x,y. Pixels outside the image are skipped.
+Cu::ForeignFunc::Result
+WriteImageRect( Cu::FFIServices&, Image&, Cu::NumericObject&, Cu::NumericObject&, Cu::NumericObject&, PixelBuffer& );
+
+// image_fill( image, color )
+// Sets every pixel of the image to the color.
+Cu::ForeignFunc::Result
+FillImage( Cu::FFIServices&, Image&, Cu::Object& );
+
+// image_blit( destination, source, x, y )
+// Copies the source image into the destination with its upper left corner at x,y, converting the color format.
+Cu::ForeignFunc::Result
+BlitImage( Cu::FFIServices&, Image&, Image&, Cu::NumericObject&, Cu::NumericObject& );
+
+// image_blend( destination, source, x, y [, opacity] )
+// Draws the source image over the destination with its upper left corner at x,y using the source alpha
+// scaled by the opacity (0 to 255, default 255).
+Cu::ForeignFunc::Result
+BlendImage( Cu::FFIServices&, Image&, Image&, Cu::NumericObject&, Cu::NumericObject&, Optional<Cu::NumericObject&> );
+
+// image_premultiply( image )
+// Multiplies the color channels of each pixel by its alpha.
+Cu::ForeignFunc::Result
+PremultiplyImage( Cu::FFIServices&, Image& );
+
+// texture_update( texture, image, [rect] )
+// Copies the area of the image changed since the last update (or the given rectangle) into the texture.
+// The texture must be the same size as the image.
+Cu::ForeignFunc::Result
+UpdateTexture( Cu::FFIServices&, Texture&, Image&, Optional<Cu::Object&> );
+
+//! Reads the rectangle at the given arg, which is a cubrrect or an object with members x, y, x2, y2.
+// Prints a warning and returns false if it is neither.
+bool
+getRectArg( Cu::FFIServices&, Cu::UInteger  index, rect_t&  out );
+
+// image_view( image, rect )
+// Returns an image that shares the pixels of the rectangle of the given image.
+Cu::ForeignFunc::Result
+CreateImageView( Cu::FFIServices&, Image&, Cu::Object& );
+
+//! Returns a new image with the pixels of the image or region view in the given color format.
+// Drop the result when done. Used by image_convert() and image_to_texture().
+image_t*
+createImageCopy( Image&  source, irr::video::ECOLOR_FORMAT );
 
 } // cubr
 
@@ -0,0 +1,277 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_imgjob.h"
+#include "cubr_pixfmt.h"
+#include <cstdio>
+
+namespace cubr {
+
+using irr::u8;
+using irr::u32;
+
+//----- ImageJob
+
+ImageJob::ImageJob( Kernel::Value  k, Image*  src, Image&  dest )
+	: ThreadPool::Batch( countTiles(dest) )
+	, vertical(false)
+	, kernel(k)
+	, source()
+	, target()
+	, sourcePixels()
+	, targetPixels()
+	, tilesAcross( (dest.getSize().Width + TILE_SIZE - 1) / TILE_SIZE )
+{
+	u32  i = 0;
+	colors[0] = colors[1] = 0xff000000;
+	for (; i < 16; ++i)
+		matrix[i] = (i % 5 == 0) ? 1.f : 0.f; // Identity
+
+	// Locking the target first unshares it, so the image kept must be the one returned afterwards
+	dest.lockPixels(targetPixels, true);
+	target.set( dest.getImage() );
+	if ( src ) {
+		src->lockPixels(sourcePixels, false);
+		source.set( src->getImage() );
+	}
+}
+
+ImageJob::~ImageJob() {
+	if ( source )
+		source.access().unlock();
+	if ( target )
+		target.access().unlock();
+}
+
+image_t*
+ImageJob::getTarget() {
+	return target.get();
+}
+
+u32
+ImageJob::countTiles( Image&  img ) {
+	const irr::core::dimension2du  size = img.getSize();
+	return ((size.Width + TILE_SIZE - 1) / TILE_SIZE) * ((size.Height + TILE_SIZE - 1) / TILE_SIZE);
+}
+
+void
+ImageJob::runPart( u32  part ) {
+	const irr::core::dimension2du  size = targetPixels.size;
+	const irr::video::ECOLOR_FORMAT  format = targetPixels.format;
+	const u32  x = (part % tilesAcross) * TILE_SIZE;
+	const u32  top = (part / tilesAcross) * TILE_SIZE;
+	const u32  width = irr::core::min_( (u32)TILE_SIZE, size.Width - x );
+	const u32  bottom = irr::core::min_( top + TILE_SIZE, size.Height );
+	u32  row[TILE_SIZE];
+	u8*  d;
+	u32  y = top;
+
+	for (; y < bottom; ++y) {
+		d = targetPixels.at( (irr::s32)x, (irr::s32)y );
+		switch( kernel ) {
+		case Kernel::Fill:
+			fillPixelsARGB( colors[0], format, d, width );
+			break;
+
+		case Kernel::Gradient:
+			runGradient( row, x, y, width );
+			writePixelsARGB( row, format, d, width );
+			break;
+
+		case Kernel::Convert:
+			readPixelsARGB( sourcePixels.at( (irr::s32)x, (irr::s32)y ), sourcePixels.format, row, width );
+			writePixelsARGB( row, format, d, width );
+			break;
+
+		case Kernel::Resample:
+			runResample( row, x, y, width );
+			writePixelsARGB( row, format, d, width );
+			break;
+
+		case Kernel::ColorMatrix:
+			readPixelsARGB( d, format, row, width );
+			runColorMatrix( row, width );
+			writePixelsARGB( row, format, d, width );
+			break;
+
+		default: break;
+		}
+	}
+}
+
+// Blends the channels of a and b with a weight of b from 0 to 256
+static inline u32
+lerpARGB( u32  a, u32  b, u32  weight ) {
+	const u32  wa = 256 - weight;
+	return ( (((a & 0x00ff00ff) * wa + (b & 0x00ff00ff) * weight) >> 8) & 0x00ff00ff )
+		| ( (((a >> 8) & 0x00ff00ff) * wa + ((b >> 8) & 0x00ff00ff) * weight) & 0xff00ff00 );
+}
+
+void
+ImageJob::runGradient( u32*  row, u32  x, u32  y, u32  width ) {
+	const irr::core::dimension2du  size = targetPixels.size;
+	const u32  length = vertical ? size.Height : size.Width;
+	u32  i = 0;
+	if ( vertical ) {
+		const u32  c = lerpARGB( colors[0], colors[1], length > 1 ? (y * 256) / (length - 1) : 0 );
+		for (; i < width; ++i)
+			row[i] = c;
+	} else {
+		for (; i < width; ++i)
+			row[i] = lerpARGB( colors[0], colors[1], length > 1 ? ((x + i) * 256) / (length - 1) : 0 );
+	}
+}
+
+void
+ImageJob::runResample( u32*  row, u32  x, u32  y, u32  width ) {
+	const irr::core::dimension2du  sourceSize = sourcePixels.size;
+	const irr::core::dimension2du  targetSize = targetPixels.size;
+	const irr::video::ECOLOR_FORMAT  format = sourcePixels.format;
+	u32  top[2];
+	u32  bottom[2];
+	u32  i = 0;
+
+	if ( sourceSize.Width == 0 || sourceSize.Height == 0 ) {
+		for (; i < width; ++i)
+			row[i] = 0;
+		return;
+	}
+
+	// Source position in 1/256 pixels, centered on the target pixel
+	irr::s32  sy = (irr::s32)( ((irr::s64)(2 * y + 1) * sourceSize.Height * 128) / targetSize.Height ) - 128;
+	sy = irr::core::clamp( sy, 0, (irr::s32)(sourceSize.Height - 1) * 256 );
+	const u32  y0 = (u32)sy >> 8;
+	const u32  y1 = irr::core::min_( y0 + 1, sourceSize.Height - 1 );
+	const u32  wy = (u32)sy & 0xff;
+	irr::s32  sx;
+	u32  x0, x1, wx;
+
+	for (; i < width; ++i) {
+		sx = (irr::s32)( ((irr::s64)(2 * (x + i) + 1) * sourceSize.Width * 128) / targetSize.Width ) - 128;
+		sx = irr::core::clamp( sx, 0, (irr::s32)(sourceSize.Width - 1) * 256 );
+		x0 = (u32)sx >> 8;
+		x1 = irr::core::min_( x0 + 1, sourceSize.Width - 1 );
+		wx = (u32)sx & 0xff;
+
+		readPixelsARGB( sourcePixels.at(x0, y0), format, &top[0], 1 );
+		readPixelsARGB( sourcePixels.at(x1, y0), format, &top[1], 1 );
+		readPixelsARGB( sourcePixels.at(x0, y1), format, &bottom[0], 1 );
+		readPixelsARGB( sourcePixels.at(x1, y1), format, &bottom[1], 1 );
+		row[i] = lerpARGB( lerpARGB(top[0], top[1], wx), lerpARGB(bottom[0], bottom[1], wx), wy );
+	}
+}
+
+static inline u32
+toChannel( irr::f32  v ) {
+	return v <= 0.f ? 0 : ( v >= 255.f ? 255 : (u32)(v + 0.5f) );
+}
+
+void
+ImageJob::runColorMatrix( u32*  row, u32  width ) {
+	const irr::f32*  m = matrix;
+	irr::f32  r, g, b, a;
+	u32  i = 0;
+	for (; i < width; ++i) {
+		r = (irr::f32)((row[i] >> 16) & 0xff);
+		g = (irr::f32)((row[i] >> 8) & 0xff);
+		b = (irr::f32)(row[i] & 0xff);
+		a = (irr::f32)(row[i] >> 24);
+		row[i] = ( toChannel( m[12]*r + m[13]*g + m[14]*b + m[15]*a ) << 24 )
+			| ( toChannel( m[0]*r + m[1]*g + m[2]*b + m[3]*a ) << 16 )
+			| ( toChannel( m[4]*r + m[5]*g + m[6]*b + m[7]*a ) << 8 )
+			| toChannel( m[8]*r + m[9]*g + m[10]*b + m[11]*a );
+	}
+}
+
+//----- ImageJobHandle
+
+bool isImageJobObject( Cu::Object&  object ) {
+	return object.getType() == ImageJobHandle::getTypeAsCuType();
+}
+
+ImageJobHandle::ImageJobHandle( ImageJob*  j, Cu::Object*  r, Cu::Object*  i, Image*  o )
+	: Cu::Object( ImageJobHandle::getTypeAsCuType() )
+	, job(j)
+	, result(r)
+	, input(i)
+	, output(o)
+{
+	if ( result )
+		result->ref();
+	if ( input )
+		input->ref();
+	if ( output )
+		output->ref();
+}
+
+ImageJobHandle::~ImageJobHandle() {
+	job->wait();
+	finish();
+	delete job;
+	if ( result )
+		result->deref();
+	if ( input )
+		input->deref();
+}
+
+ImageJob*
+ImageJobHandle::getJob() {
+	return job;
+}
+
+Cu::Object*
+ImageJobHandle::getResult() {
+	return result;
+}
+
+bool
+ImageJobHandle::finish() {
+	if ( ! job->isDone() )
+		return false;
+	if ( output ) {
+		Image*  image = (Image*)result;
+		( image->isRegion() ? image->getParent() : image )->share(*output);
+		image->setAllDirty();
+		output->deref();
+		output = REAL_NULL;
+	}
+	return true;
+}
+
+Cu::Object*
+ImageJobHandle::copy() {
+	// A job cannot be copied
+	this->ref();
+	return this;
+}
+
+void
+ImageJobHandle::writeToString(String& out) const {
+	out = job->isDone() ? "{CuBridge ImageJob done}" : "{CuBridge ImageJob running}";
+}
+
+const char*
+ImageJobHandle::typeName() const {
+	return ImageJobHandle::StaticTypeName();
+}
+
+bool
+ImageJobHandle::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == ImageJobHandle::getTypeAsCuType();
+}
+
+//----- Foreign functions
+
+Cu::ForeignFunc::Result
+IsImageJobDone( Cu::FFIServices&  ffi, ImageJobHandle&  handle ) {
+	ffi.setNewResult( new Cu::BoolObject( handle.finish() ) );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+Cu::ForeignFunc::Result
+GetImageJobResult( Cu::FFIServices&  ffi, ImageJobHandle&  handle ) {
+	if ( handle.finish() && handle.getResult() )
+		ffi.setResult( handle.getResult() );
+	return Cu::ForeignFunc::FINISHED;
+}
+
+}
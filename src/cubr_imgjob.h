@@ -0,0 +1,144 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_IMGJOB_H_
+#define _CUBR_IMGJOB_H_
+
+#include <Copper.h>
+#include "cubr_base.h"
+#include "cubr_threadpool.h"
+
+namespace cubr {
+
+//! Image Job
+/*
+	Runs a kernel over an image or region view in square tiles, one tile per part of the batch.
+	Images are locked when the job is created and must not be changed by anything else until the job is done.
+	The job must be destroyed on the thread that created it since it holds references to the images.
+*/
+class ImageJob : public ThreadPool::Batch {
+public:
+	enum { TILE_SIZE = 128 };
+
+	struct Kernel {
+	enum Value {
+		Fill, // Sets every pixel to colors[0]
+		Gradient, // Blends from colors[0] to colors[1] across the image, or down if vertical is set
+		Convert, // Copies the source into the target, which has a different color format
+		Resample, // Scales the source to the size of the target (bilinear)
+		ColorMatrix, // Multiplies the red, green, blue and alpha of each pixel by the matrix
+	};};
+
+	//! Fill, Gradient and ColorMatrix change the target in place and ignore the source.
+	//! Both images must have color formats supported by cubr_pixfmt.h.
+	ImageJob( Kernel::Value, Image*  source, Image&  target );
+
+	~ImageJob();
+
+	// Kernel settings. Set before submitting.
+	irr::u32  colors[2];
+	bool  vertical;
+	// Row-major: row 0 gives the new red from the old red, green, blue and alpha, row 1 the green, etc.
+	irr::f32  matrix[16];
+
+	image_t*
+	getTarget();
+
+protected:
+	virtual void
+	runPart( irr::u32 );
+
+private:
+	Kernel::Value  kernel;
+	irrptr<image_t>  source;
+	irrptr<image_t>  target;
+	PixelRect  sourcePixels;
+	PixelRect  targetPixels;
+	irr::u32  tilesAcross;
+
+	static irr::u32
+	countTiles( Image& );
+
+	void
+	runGradient( irr::u32*  row, irr::u32  x, irr::u32  y, irr::u32  width );
+
+	void
+	runResample( irr::u32*  row, irr::u32  x, irr::u32  y, irr::u32  width );
+
+	void
+	runColorMatrix( irr::u32*  row, irr::u32  width );
+};
+
+bool
+isImageJobObject( Cu::Object& );
+
+//! Image Job Handle
+/*
+	Copper object for polling a job submitted with image_job().
+	Destroying the handle waits for the job to finish.
+*/
+class ImageJobHandle : public Cu::Object {
+	ImageJob*  job;
+	Cu::Object*  result;
+	Cu::Object*  input;
+	Image*  output;
+
+public:
+	//! Takes ownership of the job. The result is the image returned by job_result() once the job is done.
+	//! The input, if any, is a copy of the source image that is kept so that the script cannot change the
+	//! source buffer while the job reads it (see Image::getWritableImage()).
+	//! The output, if any, is a private copy of the result (or of its parent, for region views) that the job
+	//! changes instead of the result, since the script can still read the result while the job runs.
+	ImageJobHandle( ImageJob*, Cu::Object*  result, Cu::Object*  input, Image*  output = REAL_NULL );
+
+	~ImageJobHandle();
+
+	ImageJob*
+	getJob();
+
+	//! Returns false if the job is still running. Otherwise, the result is given the pixels of the output
+	//! the first time this is called. Must be called on the thread that created the handle.
+	bool
+	finish();
+
+	Cu::Object*
+	getResult();
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubrjob";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::ImageJob );
+	}
+};
+
+// job_done( job )
+// Returns true if the job has finished.
+Cu::ForeignFunc::Result
+IsImageJobDone( Cu::FFIServices&, ImageJobHandle& );
+
+// job_result( job )
+// Returns the image of the job if it has finished, otherwise nothing.
+Cu::ForeignFunc::Result
+GetImageJobResult( Cu::FFIServices&, ImageJobHandle& );
+
+}
+
+#endif
@@ -0,0 +1,258 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_imgkern.h"
+
+#if !defined(CUBR_NO_SIMD) && defined(__AVX2__)
+	#define CUBR_KERNEL_AVX2
+	#include <immintrin.h>
+#endif
+#if !defined(CUBR_NO_SIMD) && ( defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) )
+	#define CUBR_KERNEL_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace cubr {
+
+using irr::u32;
+
+// Divides by 255 with rounding. Exact for x from 0 to 255*255.
+static inline u32
+div255( u32  x ) {
+	x += 128;
+	return (x + (x >> 8)) >> 8;
+}
+
+const char*
+getImageKernelPath() {
+#if defined(CUBR_KERNEL_AVX2)
+	return "AVX2";
+#elif defined(CUBR_KERNEL_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+//----- Scalar
+
+void
+fillSpanARGBScalar( u32*  dst, u32  count, u32  color ) {
+	u32  i = 0;
+	for (; i < count; ++i)
+		dst[i] = color;
+}
+
+// The alpha channel is blended as if the source alpha were 255, which gives a + da * (255 - a) / 255.
+static inline u32
+blendPixel( u32  d, u32  s, u32  opacity ) {
+	const u32  a = div255( (s >> 24) * opacity );
+	const u32  ia = 255 - a;
+	s |= 0xff000000;
+	return div255( (s & 0xff) * a + (d & 0xff) * ia )
+		| ( div255( ((s >> 8) & 0xff) * a + ((d >> 8) & 0xff) * ia ) << 8 )
+		| ( div255( ((s >> 16) & 0xff) * a + ((d >> 16) & 0xff) * ia ) << 16 )
+		| ( div255( (s >> 24) * a + (d >> 24) * ia ) << 24 );
+}
+
+void
+blendSpanARGBScalar( u32*  dst, const u32*  src, u32  count, u32  opacity ) {
+	u32  i = 0;
+	if ( opacity > 255 )
+		opacity = 255;
+	for (; i < count; ++i)
+		dst[i] = blendPixel(dst[i], src[i], opacity);
+}
+
+static inline u32
+premultiplyPixel( u32  c ) {
+	const u32  a = c >> 24;
+	return div255( (c & 0xff) * a )
+		| ( div255( ((c >> 8) & 0xff) * a ) << 8 )
+		| ( div255( ((c >> 16) & 0xff) * a ) << 16 )
+		| ( c & 0xff000000 );
+}
+
+void
+premultiplySpanARGBScalar( u32*  dst, u32  count ) {
+	u32  i = 0;
+	for (; i < count; ++i)
+		dst[i] = premultiplyPixel(dst[i]);
+}
+
+//----- SSE2
+// Pixels are unpacked to 16 bits per channel, two pixels per register half.
+
+#ifdef CUBR_KERNEL_SSE2
+
+static inline __m128i
+div255x8( __m128i  x ) {
+	x = _mm_add_epi16(x, _mm_set1_epi16(128));
+	return _mm_srli_epi16( _mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8 );
+}
+
+// Spreads the 32-bit values of the low two lanes over four 16-bit channels each
+static inline __m128i
+spreadLow( __m128i  v ) {
+	v = _mm_unpacklo_epi32(v, v);
+	v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0,0,0,0));
+	return _mm_shufflehi_epi16(v, _MM_SHUFFLE(0,0,0,0));
+}
+
+static inline __m128i
+spreadHigh( __m128i  v ) {
+	return spreadLow( _mm_unpackhi_epi64(v, v) );
+}
+
+static inline __m128i
+blend4( __m128i  d, __m128i  s, __m128i  opacity ) {
+	const __m128i  zero = _mm_setzero_si128();
+	const __m128i  full = _mm_set1_epi16(255);
+	const __m128i  a = div255x8( _mm_mullo_epi16( _mm_srli_epi32(s, 24), opacity ) );
+	s = _mm_or_si128( s, _mm_set1_epi32((int)0xff000000) );
+
+	const __m128i  aLo = spreadLow(a);
+	const __m128i  aHi = spreadHigh(a);
+	const __m128i  lo = div255x8( _mm_add_epi16(
+		_mm_mullo_epi16( _mm_unpacklo_epi8(s, zero), aLo ),
+		_mm_mullo_epi16( _mm_unpacklo_epi8(d, zero), _mm_sub_epi16(full, aLo) ) ) );
+	const __m128i  hi = div255x8( _mm_add_epi16(
+		_mm_mullo_epi16( _mm_unpackhi_epi8(s, zero), aHi ),
+		_mm_mullo_epi16( _mm_unpackhi_epi8(d, zero), _mm_sub_epi16(full, aHi) ) ) );
+	return _mm_packus_epi16(lo, hi);
+}
+
+static inline __m128i
+premultiply4( __m128i  c ) {
+	const __m128i  zero = _mm_setzero_si128();
+	// Alpha is multiplied by 255 so that it is unchanged
+	const __m128i  keepAlpha = _mm_set_epi16(255,0,0,0,255,0,0,0);
+	const __m128i  colorMask = _mm_set_epi16(0,-1,-1,-1,0,-1,-1,-1);
+	const __m128i  a = _mm_srli_epi32(c, 24);
+	const __m128i  aLo = _mm_or_si128( _mm_and_si128(spreadLow(a), colorMask), keepAlpha );
+	const __m128i  aHi = _mm_or_si128( _mm_and_si128(spreadHigh(a), colorMask), keepAlpha );
+	const __m128i  lo = div255x8( _mm_mullo_epi16( _mm_unpacklo_epi8(c, zero), aLo ) );
+	const __m128i  hi = div255x8( _mm_mullo_epi16( _mm_unpackhi_epi8(c, zero), aHi ) );
+	return _mm_packus_epi16(lo, hi);
+}
+
+#endif
+
+//----- AVX2
+// The same as SSE2 on each 128-bit half.
+
+#ifdef CUBR_KERNEL_AVX2
+
+static inline __m256i
+div255x16( __m256i  x ) {
+	x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+	return _mm256_srli_epi16( _mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8 );
+}
+
+static inline __m256i
+spreadLow8( __m256i  v ) {
+	v = _mm256_unpacklo_epi32(v, v);
+	v = _mm256_shufflelo_epi16(v, _MM_SHUFFLE(0,0,0,0));
+	return _mm256_shufflehi_epi16(v, _MM_SHUFFLE(0,0,0,0));
+}
+
+static inline __m256i
+spreadHigh8( __m256i  v ) {
+	return spreadLow8( _mm256_unpackhi_epi64(v, v) );
+}
+
+static inline __m256i
+blend8( __m256i  d, __m256i  s, __m256i  opacity ) {
+	const __m256i  zero = _mm256_setzero_si256();
+	const __m256i  full = _mm256_set1_epi16(255);
+	const __m256i  a = div255x16( _mm256_mullo_epi16( _mm256_srli_epi32(s, 24), opacity ) );
+	s = _mm256_or_si256( s, _mm256_set1_epi32((int)0xff000000) );
+
+	const __m256i  aLo = spreadLow8(a);
+	const __m256i  aHi = spreadHigh8(a);
+	const __m256i  lo = div255x16( _mm256_add_epi16(
+		_mm256_mullo_epi16( _mm256_unpacklo_epi8(s, zero), aLo ),
+		_mm256_mullo_epi16( _mm256_unpacklo_epi8(d, zero), _mm256_sub_epi16(full, aLo) ) ) );
+	const __m256i  hi = div255x16( _mm256_add_epi16(
+		_mm256_mullo_epi16( _mm256_unpackhi_epi8(s, zero), aHi ),
+		_mm256_mullo_epi16( _mm256_unpackhi_epi8(d, zero), _mm256_sub_epi16(full, aHi) ) ) );
+	return _mm256_packus_epi16(lo, hi);
+}
+
+static inline __m256i
+premultiply8( __m256i  c ) {
+	const __m256i  zero = _mm256_setzero_si256();
+	const __m256i  keepAlpha = _mm256_set_epi16(255,0,0,0,255,0,0,0, 255,0,0,0,255,0,0,0);
+	const __m256i  colorMask = _mm256_set_epi16(0,-1,-1,-1,0,-1,-1,-1, 0,-1,-1,-1,0,-1,-1,-1);
+	const __m256i  a = _mm256_srli_epi32(c, 24);
+	const __m256i  aLo = _mm256_or_si256( _mm256_and_si256(spreadLow8(a), colorMask), keepAlpha );
+	const __m256i  aHi = _mm256_or_si256( _mm256_and_si256(spreadHigh8(a), colorMask), keepAlpha );
+	const __m256i  lo = div255x16( _mm256_mullo_epi16( _mm256_unpacklo_epi8(c, zero), aLo ) );
+	const __m256i  hi = div255x16( _mm256_mullo_epi16( _mm256_unpackhi_epi8(c, zero), aHi ) );
+	return _mm256_packus_epi16(lo, hi);
+}
+
+#endif
+
+//----- Dispatch
+
+void
+fillSpanARGB( u32*  dst, u32  count, u32  color ) {
+	u32  i = 0;
+#if defined(CUBR_KERNEL_AVX2)
+	const __m256i  c8 = _mm256_set1_epi32((int)color);
+	for (; i + 8 <= count; i += 8)
+		_mm256_storeu_si256( (__m256i*)(dst + i), c8 );
+#endif
+#if defined(CUBR_KERNEL_SSE2)
+	const __m128i  c4 = _mm_set1_epi32((int)color);
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_si128( (__m128i*)(dst + i), c4 );
+#endif
+	fillSpanARGBScalar(dst + i, count - i, color);
+}
+
+void
+blendSpanARGB( u32*  dst, const u32*  src, u32  count, u32  opacity ) {
+	u32  i = 0;
+	if ( opacity > 255 )
+		opacity = 255;
+#if defined(CUBR_KERNEL_AVX2)
+	const __m256i  op8 = _mm256_set1_epi32((int)opacity);
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_si256( (__m256i*)(dst + i), blend8(
+			_mm256_loadu_si256( (const __m256i*)(dst + i) ),
+			_mm256_loadu_si256( (const __m256i*)(src + i) ),
+			op8 ) );
+	}
+#endif
+#if defined(CUBR_KERNEL_SSE2)
+	const __m128i  op4 = _mm_set1_epi32((int)opacity);
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_si128( (__m128i*)(dst + i), blend4(
+			_mm_loadu_si128( (const __m128i*)(dst + i) ),
+			_mm_loadu_si128( (const __m128i*)(src + i) ),
+			op4 ) );
+	}
+#endif
+	blendSpanARGBScalar(dst + i, src + i, count - i, opacity);
+}
+
+void
+premultiplySpanARGB( u32*  dst, u32  count ) {
+	u32  i = 0;
+#if defined(CUBR_KERNEL_AVX2)
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_si256( (__m256i*)(dst + i),
+			premultiply8( _mm256_loadu_si256( (const __m256i*)(dst + i) ) ) );
+	}
+#endif
+#if defined(CUBR_KERNEL_SSE2)
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_si128( (__m128i*)(dst + i),
+			premultiply4( _mm_loadu_si128( (const __m128i*)(dst + i) ) ) );
+	}
+#endif
+	premultiplySpanARGBScalar(dst + i, count - i);
+}
+
+}
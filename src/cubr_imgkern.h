@@ -0,0 +1,48 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_IMGKERN_H_
+#define _CUBR_IMGKERN_H_
+
+#include <irrTypes.h> // from Irrlicht
+
+// Uncomment to build only the scalar kernels
+//#define CUBR_NO_SIMD
+
+namespace cubr {
+
+//! Image kernels
+/*
+	Operations on spans of A8R8G8B8 pixels (the layout of SColor::color).
+	Each kernel uses AVX2 or SSE2 when the compiler targets it (e.g. -mavx2) and falls back to the
+	scalar version otherwise. The scalar versions are always available and give identical results.
+	Colors are not premultiplied unless stated.
+*/
+
+//! Returns the name of the instruction set used by the kernels: "AVX2", "SSE2" or "scalar".
+const char*
+getImageKernelPath();
+
+//! Sets count pixels to the color.
+void
+fillSpanARGB( irr::u32*  dst, irr::u32  count, irr::u32  color );
+
+void
+fillSpanARGBScalar( irr::u32*  dst, irr::u32  count, irr::u32  color );
+
+//! Draws src over dst using the src alpha scaled by opacity (0 to 255).
+void
+blendSpanARGB( irr::u32*  dst, const irr::u32*  src, irr::u32  count, irr::u32  opacity );
+
+void
+blendSpanARGBScalar( irr::u32*  dst, const irr::u32*  src, irr::u32  count, irr::u32  opacity );
+
+//! Multiplies the color channels by the alpha.
+void
+premultiplySpanARGB( irr::u32*  dst, irr::u32  count );
+
+void
+premultiplySpanARGBScalar( irr::u32*  dst, irr::u32  count );
+
+}
+
+#endif
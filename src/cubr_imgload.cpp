@@ -0,0 +1,249 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_imgload.h"
+#include "cubridge.h"
+#include "cubr_str.h"
+#include <cstdio>
+
+namespace cubr {
+
+using irr::u32;
+
+std::mutex&
+getImageDecodeLock() {
+	static std::mutex  lock;
+	return lock;
+}
+
+//----- ImageReadBatch
+
+ImageReadBatch::ImageReadBatch(
+	video_driver_t*  driver,
+	irr::io::IFileSystem*  files,
+	const irr::core::array<util::String>&  n,
+	const irr::core::array<bool>&  d
+)
+	: ThreadPool::Batch( n.size() )
+	, videoDriver(driver)
+	, fileSystem(files)
+	, names(n)
+	, paths()
+	, decode(d)
+	, images()
+{
+	u32  i = 0;
+	// Reference counts and Copper strings are only touched on the main thread
+	videoDriver->grab();
+	fileSystem->grab();
+	paths.reallocate(names.size());
+	images.reallocate(names.size());
+	for (; i < names.size(); ++i) {
+		paths.push_back( CuStrToIrrPath(names[i]) );
+		images.push_back(0);
+	}
+}
+
+ImageReadBatch::~ImageReadBatch() {
+	u32  i = 0;
+	wait();
+	for (; i < images.size(); ++i) {
+		if ( images[i] )
+			images[i]->drop();
+	}
+	fileSystem->drop();
+	videoDriver->drop();
+}
+
+image_t*
+ImageReadBatch::takeImage( u32  index ) {
+	image_t*  img = images[index];
+	images[index] = 0;
+	return img;
+}
+
+void
+ImageReadBatch::runPart( u32  part ) {
+	irr::c8*  data;
+	long  size;
+	std::FILE*  stream;
+	irr::io::IReadFile*  file;
+
+	if ( ! decode[part] )
+		return;
+	stream = std::fopen( names[part].c_str(), "rb" );
+	if ( ! stream )
+		return;
+	if ( std::fseek(stream, 0, SEEK_END) != 0 || (size = std::ftell(stream)) <= 0 || std::fseek(stream, 0, SEEK_SET) != 0 ) {
+		std::fclose(stream);
+		return;
+	}
+	data = new irr::c8[size];
+	if ( std::fread(data, 1, (size_t)size, stream) != (size_t)size ) {
+		std::fclose(stream);
+		delete[] data;
+		return;
+	}
+	std::fclose(stream);
+
+	std::lock_guard<std::mutex>  lock( getImageDecodeLock() );
+	// The file deletes the data. The name lets the driver pick the loader by extension.
+	file = fileSystem->createMemoryReadFile( data, (irr::s32)size, paths[part], true );
+	images[part] = videoDriver->createImageFromFile(file);
+	file->drop();
+}
+
+//----- ImageLoad
+
+bool isImageLoadObject( Cu::Object&  object ) {
+	return object.getType() == ImageLoad::getTypeAsCuType();
+}
+
+ImageLoad::ImageLoad(
+	video_driver_t*  driver,
+	irr::io::IFileSystem*  fileSystem,
+	const irr::core::array<util::String>&  n,
+	const irr::core::array<bool>&  decode,
+	bool  textures
+)
+	: Cu::Object( ImageLoad::getTypeAsCuType() )
+	, videoDriver(driver)
+	, batch( new ImageReadBatch(driver, fileSystem, n, decode) )
+	, names(n)
+	, makeTextures(textures)
+	, finishedCount(0)
+	, loadedCount(0)
+	, result(REAL_NULL)
+	, callback(REAL_NULL)
+{}
+
+ImageLoad::~ImageLoad() {
+	delete batch;
+	if ( result )
+		result->deref();
+	if ( callback ) {
+		callback->disown(this);
+		callback->deref();
+	}
+}
+
+ThreadPool::Batch*
+ImageLoad::getBatch() {
+	return batch;
+}
+
+bool
+ImageLoad::isRead() {
+	return batch->isDone();
+}
+
+bool
+ImageLoad::isFinished() const {
+	return finishedCount == names.size();
+}
+
+u32
+ImageLoad::finish( CuBridge&  bridge, u32  maxFiles ) {
+	const u32  end = ( maxFiles == 0 || finishedCount + maxFiles > names.size() ) ? names.size() : finishedCount + maxFiles;
+	const u32  start = finishedCount;
+	TextureManager&  textureManager = bridge.getTextureManager();
+	image_t*  img;
+	texture_t*  tex;
+
+	if ( ! isRead() )
+		return 0;
+
+	for (; finishedCount < end; ++finishedCount) {
+		img = batch->takeImage(finishedCount);
+		if ( ! makeTextures ) {
+			if ( ! img )
+				img = bridge.loadImage( names[finishedCount] );
+			if ( img ) {
+				result = new Image(img, videoDriver);
+				img->drop();
+				++loadedCount;
+			}
+		} else {
+			// The texture may have been loaded some other way since the load was started
+			tex = textureManager.find( names[finishedCount] );
+			if ( ! tex ) {
+				// Only the upload happens here for decoded files
+				tex = img ? videoDriver->addTexture( CuStrToIrrPath(names[finishedCount]), img )
+					: bridge.getTexture( names[finishedCount] );
+				if ( tex )
+					textureManager.add( names[finishedCount], tex );
+			}
+			if ( tex )
+				++loadedCount;
+			if ( img )
+				img->drop();
+		}
+	}
+
+	if ( makeTextures && isFinished() && ! result )
+		result = new Cu::IntegerObject( (Cu::Integer)loadedCount );
+	return finishedCount - start;
+}
+
+Cu::Object*
+ImageLoad::getResult() {
+	return isFinished() ? result : REAL_NULL;
+}
+
+void
+ImageLoad::setCallback( Cu::FunctionObject*  f ) {
+	if ( callback ) {
+		callback->disown(this);
+		callback->deref();
+	}
+	callback = f;
+	if ( callback ) {
+		callback->ref();
+		callback->changeOwnerTo(this);
+	}
+}
+
+Cu::FunctionObject*
+ImageLoad::getCallback() {
+	return callback;
+}
+
+bool
+ImageLoad::owns( Cu::FunctionObject*  container ) const {
+	return notNull(callback) && callback == container;
+}
+
+Cu::Object*
+ImageLoad::copy() {
+	// A load cannot be copied
+	this->ref();
+	return this;
+}
+
+void
+ImageLoad::writeToString(String& out) const {
+	char  buffer[60];
+	std::snprintf(buffer, 60, "{CuBridge ImageLoad %u/%u}", finishedCount, names.size());
+	out = buffer;
+}
+
+const char*
+ImageLoad::typeName() const {
+	return ImageLoad::StaticTypeName();
+}
+
+bool
+ImageLoad::supportsInterface( Cu::ObjectType::Value  t ) const {
+	return t == ImageLoad::getTypeAsCuType();
+}
+
+//----- Foreign functions
+
+Cu::ForeignFunc::Result
+GetImageLoadResult( Cu::FFIServices&  ffi, ImageLoad&  load ) {
+	Cu::Object*  result = load.getResult();
+	if ( result )
+		ffi.setResult(result);
+	return Cu::ForeignFunc::FINISHED;
+}
+
+}
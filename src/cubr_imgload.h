@@ -0,0 +1,163 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_IMGLOAD_H_
+#define _CUBR_IMGLOAD_H_
+
+#include <Copper.h>
+#include <irrArray.h> // from Irrlicht
+#include "cubr_base.h"
+#include "cubr_threadpool.h"
+#include <IFileSystem.h> // from Irrlicht
+#include <mutex>
+
+namespace cubr {
+
+class CuBridge;
+
+//! Held while an image is decoded off the main thread.
+// Some of Irrlicht's image loaders keep state in statics, so CuBridge::loadImage() and CuBridge::getTexture()
+// hold it as well.
+std::mutex&
+getImageDecodeLock();
+
+//! Image Read Batch
+/*
+	Reads image files on the thread pool, one file per part, and decodes them from memory with the
+	image loaders of the video driver. Files are read in parallel but decoded one at a time (see getImageDecodeLock()).
+	Files are opened with the C library since files in archives share the read position of the archive.
+	Those that cannot be opened directly, or are not to be decoded here, are left to the main thread.
+	Decoding errors are logged from the pool thread, so event receivers must not expect log events only
+	on the main thread.
+*/
+class ImageReadBatch : public ThreadPool::Batch {
+	video_driver_t*  videoDriver;
+	irr::io::IFileSystem*  fileSystem;
+	irr::core::array<util::String>  names;
+	irr::core::array<irr::io::path>  paths;
+	irr::core::array<bool>  decode;
+	irr::core::array<image_t*>  images; // Null until decoded
+
+public:
+	//! Only files whose decode flag is set are read.
+	ImageReadBatch(
+		video_driver_t*,
+		irr::io::IFileSystem*,
+		const irr::core::array<util::String>&  names,
+		const irr::core::array<bool>&  decode
+	);
+
+	//! Waits for the batch and drops the images not taken
+	~ImageReadBatch();
+
+	//! Returns the decoded image of the file, or null if it was not decoded, and gives it to the caller to drop.
+	//! Only call once the batch is done.
+	image_t*
+	takeImage( irr::u32 );
+
+protected:
+	virtual void
+	runPart( irr::u32 );
+};
+
+bool
+isImageLoadObject( Cu::Object& );
+
+//! Image Load
+/*
+	Copper handle for files being loaded by image_load_async() or texture_preload().
+	The files are read and decoded on the thread pool. Once decoded, finish() is called on the main thread
+	to turn them into the result: a cubrimage for image_load_async() or textures in the texture manager
+	for texture_preload(). finish() can spread the files over several calls.
+	Files that were not decoded on the pool are loaded by finish() with CuBridge::loadImage() or
+	CuBridge::getTexture().
+*/
+class ImageLoad : public Cu::Object, public Cu::Owner {
+	video_driver_t*  videoDriver;
+	ImageReadBatch*  batch;
+	irr::core::array<util::String>  names;
+	bool  makeTextures;
+	irr::u32  finishedCount;
+	irr::u32  loadedCount;
+	Cu::Object*  result;
+	Cu::FunctionObject*  callback;
+
+public:
+	//! Loads the named files, which are given as Copper strings. Submit getBatch() to start decoding them.
+	//! Files whose decode flag is not set are only loaded by finish().
+	ImageLoad(
+		video_driver_t*,
+		irr::io::IFileSystem*,
+		const irr::core::array<util::String>&  names,
+		const irr::core::array<bool>&  decode,
+		bool  makeTextures
+	);
+
+	~ImageLoad();
+
+	ThreadPool::Batch*
+	getBatch();
+
+	//! True once the files have been decoded on the thread pool
+	bool
+	isRead();
+
+	//! True once finish() has handled every file
+	bool
+	isFinished() const;
+
+	//! Creates the results of up to the given number of files (zero is all of them).
+	//! Textures are added to the texture manager of the bridge.
+	//! Must only be called once read. Returns the number of files handled.
+	irr::u32
+	finish( CuBridge&, irr::u32  maxFiles = 0 );
+
+	//! For image_load_async(), the cubrimage. For texture_preload(), the number of textures loaded.
+	//! Null until finished or if the image could not be loaded.
+	Cu::Object*
+	getResult();
+
+	void
+	setCallback( Cu::FunctionObject* );
+
+	Cu::FunctionObject*
+	getCallback();
+
+	// ** Cu::Owner **
+
+	virtual bool
+	owns( Cu::FunctionObject*  container ) const;
+
+	// ** Cu::Object virtual methods **
+
+	virtual Cu::Object*
+	copy();
+
+	virtual void
+	writeToString(String& out) const;
+
+	static const char*
+	StaticTypeName() {
+		return "cubrload";
+	}
+
+	virtual const char*
+	typeName() const;
+
+	virtual bool
+	supportsInterface( Cu::ObjectType::Value ) const;
+
+	// Helper
+	static Cu::ObjectType::Value
+	getTypeAsCuType() {
+		return getCubrTypeAsCuType( CubrObjectType::ImageLoad );
+	}
+};
+
+// load_result( load: )
+// Returns the result of the load if it is finished (see ImageLoad::getResult()).
+Cu::ForeignFunc::Result
+GetImageLoadResult( Cu::FFIServices&, ImageLoad& );
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_marshal.h"
+#include "cubr_texmgr.h"
+#include "cubr_evqueue.h"
+
+namespace cubr {
+
+const MarshalField<ImageSize>*
+ImageSize::fields( Cu::UInteger&  count ) {
+	static const MarshalField<ImageSize>  f[] = {
+		{ util::String("width"), &ImageSize::width },
+		{ util::String("height"), &ImageSize::height }
+	};
+	count = sizeof(f) / sizeof(f[0]);
+	return f;
+}
+
+ImageSize
+ImageSize::from( const irr::core::dimension2du&  d ) {
+	// TODO: PROBLEM: The image width is an unsigned int. What if it's value is greater than int can hold?
+	ImageSize  s = { (Cu::Integer)d.Width, (Cu::Integer)d.Height };
+	return s;
+}
+
+const MarshalField<Color>*
+Color::fields( Cu::UInteger&  count ) {
+	static const MarshalField<Color>  f[] = {
+		{ util::String("red"), &Color::red },
+		{ util::String("green"), &Color::green },
+		{ util::String("blue"), &Color::blue },
+		{ util::String("alpha"), &Color::alpha }
+	};
+	count = sizeof(f) / sizeof(f[0]);
+	return f;
+}
+
+Color
+Color::from( irr::video::SColor  c ) {
+	Color  s = { (Cu::Integer)c.getRed(), (Cu::Integer)c.getGreen(), (Cu::Integer)c.getBlue(), (Cu::Integer)c.getAlpha() };
+	return s;
+}
+
+irr::video::SColor
+Color::toSColor() const {
+	return irr::video::SColor( (irr::u32)alpha, (irr::u32)red, (irr::u32)green, (irr::u32)blue );
+}
+
+const MarshalField<RectI>*
+RectI::fields( Cu::UInteger&  count ) {
+	static const MarshalField<RectI>  f[] = {
+		{ util::String("x"), &RectI::x },
+		{ util::String("y"), &RectI::y },
+		{ util::String("x2"), &RectI::x2 },
+		{ util::String("y2"), &RectI::y2 }
+	};
+	count = sizeof(f) / sizeof(f[0]);
+	return f;
+}
+
+RectI
+RectI::from( const rect_t&  r ) {
+	RectI  s = {
+		(Cu::Integer)r.UpperLeftCorner.X, (Cu::Integer)r.UpperLeftCorner.Y,
+		(Cu::Integer)r.LowerRightCorner.X, (Cu::Integer)r.LowerRightCorner.Y
+	};
+	return s;
+}
+
+rect_t
+RectI::toRect() const {
+	return rect_t( (irr::s32)x, (irr::s32)y, (irr::s32)x2, (irr::s32)y2 );
+}
+
+const MarshalField<TextureStats>*
+TextureStats::fields( Cu::UInteger&  count ) {
+	static const MarshalField<TextureStats>  f[] = {
+		{ util::String("textures"), &TextureStats::textures },
+		{ util::String("used"), &TextureStats::used },
+		{ util::String("bytes"), &TextureStats::bytes },
+		{ util::String("budget"), &TextureStats::budget },
+		{ util::String("hits"), &TextureStats::hits },
+		{ util::String("misses"), &TextureStats::misses },
+		{ util::String("evictions"), &TextureStats::evictions }
+	};
+	count = sizeof(f) / sizeof(f[0]);
+	return f;
+}
+
+TextureStats
+TextureStats::from( const TextureManager&  manager ) {
+	TextureManager::Stats  t;
+	manager.getStats(t);
+	TextureStats  s = {
+		(Cu::Integer)t.textures, (Cu::Integer)t.used, (Cu::Integer)t.bytes, (Cu::Integer)t.budget,
+		(Cu::Integer)t.hits, (Cu::Integer)t.misses, (Cu::Integer)t.evictions
+	};
+	return s;
+}
+
+const MarshalField<EventStats>*
+EventStats::fields( Cu::UInteger&  count ) {
+	static const MarshalField<EventStats>  f[] = {
+		{ util::String("depth"), &EventStats::depth },
+		{ util::String("peak_depth"), &EventStats::peakDepth },
+		{ util::String("delivered"), &EventStats::delivered },
+		{ util::String("carried"), &EventStats::carried },
+		{ util::String("pump_time"), &EventStats::pumpTime },
+		{ util::String("max_latency"), &EventStats::maxLatency },
+		{ util::String("average_latency"), &EventStats::averageLatency }
+	};
+	count = sizeof(f) / sizeof(f[0]);
+	return f;
+}
+
+EventStats
+EventStats::from( const GUIEventQueue&  queue ) {
+	GUIEventQueue::Stats  t;
+	queue.getStats(t);
+	EventStats  s = {
+		(Cu::Integer)t.depth, (Cu::Integer)t.peakDepth, (Cu::Integer)t.delivered, (Cu::Integer)t.carried,
+		(Cu::Integer)t.pumpTime, (Cu::Integer)t.maxLatency, (Cu::Integer)t.averageLatency
+	};
+	return s;
+}
+
+}
@@ -0,0 +1,198 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_MARSHAL_H_
+#define _CUBR_MARSHAL_H_
+
+#include <Copper.h>
+#include "cubr_defs.h"
+
+namespace cubr {
+
+class TextureManager;
+class GUIEventQueue;
+
+//! Marshal Field
+/*
+	Names an integer member of a marshalled struct.
+	The name is created once so that member lookups never need to construct a string.
+*/
+template<class S>
+struct MarshalField {
+	util::String  name;
+	Cu::Integer S::*  member;
+};
+
+//! Marshal
+/*
+	Converts the struct S to and from a Copper function whose members have the names of S's fields.
+	S declares its fields via:
+		static const MarshalField<S>*  fields( Cu::UInteger& count );
+*/
+template<class S>
+struct Marshal {
+
+	//! Stores the value in the members of the target, adding the members that are missing.
+	// Members already holding an integer that nothing else shares are changed in place rather than replaced.
+	// If no target is given, a new function object is created.
+	// Returns the target.
+	static Cu::FunctionObject*
+	toCopper( const S&  value, Cu::FunctionObject*  target = REAL_NULL ) {
+		Cu::UInteger  count;
+		const MarshalField<S>*  fields = S::fields(count);
+		Cu::Function*  f;
+		Cu::Variable*  var;
+		Cu::IntegerObject*  intObject;
+		Cu::UInteger  i = 0;
+
+		if ( ! target )
+			target = new Cu::FunctionObject();
+
+		if ( target->getFunction(f) ) {
+			Cu::Scope&  scope = f->getPersistentScope();
+			for (; i < count; ++i) {
+				scope.getVariable(fields[i].name, var);
+				intObject = getOwnedInteger(*var);
+				if ( intObject ) {
+					intObject->setValue( Cu::IntegerObject( value.*(fields[i].member) ) );
+					continue;
+				}
+				intObject = new Cu::IntegerObject( value.*(fields[i].member) );
+				var->setFuncReturn(intObject, false);
+				intObject->deref();
+			}
+		}
+		return target;
+	}
+
+	//! Reads the value from the members of the source.
+	// Fields whose members are missing or not numeric are left unchanged.
+	// Returns false if the source has no function.
+	static bool
+	fromCopper( Cu::FunctionObject&  source, S&  value ) {
+		Cu::UInteger  count;
+		const MarshalField<S>*  fields = S::fields(count);
+		Cu::Function*  f;
+		Cu::Variable*  var;
+		Cu::Object*  resultObj;
+		Cu::UInteger  i = 0;
+
+		if ( ! source.getFunction(f) )
+			return false;
+
+		Cu::Scope&  scope = f->getPersistentScope();
+		for (; i < count; ++i) {
+			if ( ! scope.findVariable(fields[i].name, var) )
+				continue;
+			if ( var->getFunction(REAL_NULL)->result.obtain(resultObj) ) {
+				if ( Cu::isNumericObject(*resultObj) )
+					value.*(fields[i].member) = ((Cu::NumericObject*)resultObj)->getIntegerValue();
+			}
+		}
+		return true;
+	}
+
+private:
+	// Returns the integer held by the variable if only the variable holds it, otherwise null.
+	static Cu::IntegerObject*
+	getOwnedInteger( Cu::Variable&  var ) {
+		Cu::Object*  resultObj;
+		if ( ! var.getFunction(REAL_NULL)->result.obtain(resultObj) )
+			return REAL_NULL;
+		if ( ! Cu::isNumericObject(*resultObj)
+			|| ((Cu::NumericObject*)resultObj)->getSubType() != Cu::NumericObject::SubType::Integer
+			|| resultObj->getReferenceCount() > 1
+		) {
+			return REAL_NULL;
+		}
+		return (Cu::IntegerObject*)resultObj;
+	}
+};
+
+//! Image size
+// Copper members: width, height
+struct ImageSize {
+	Cu::Integer  width;
+	Cu::Integer  height;
+
+	static const MarshalField<ImageSize>*
+	fields( Cu::UInteger& );
+
+	static ImageSize
+	from( const irr::core::dimension2du& );
+};
+
+//! Color
+// Copper members: red, green, blue, alpha
+struct Color {
+	Cu::Integer  red;
+	Cu::Integer  green;
+	Cu::Integer  blue;
+	Cu::Integer  alpha;
+
+	static const MarshalField<Color>*
+	fields( Cu::UInteger& );
+
+	static Color
+	from( irr::video::SColor );
+
+	irr::video::SColor
+	toSColor() const;
+};
+
+//! Integer rectangle
+// Copper members: x, y, x2, y2
+struct RectI {
+	Cu::Integer  x;
+	Cu::Integer  y;
+	Cu::Integer  x2;
+	Cu::Integer  y2;
+
+	static const MarshalField<RectI>*
+	fields( Cu::UInteger& );
+
+	static RectI
+	from( const rect_t& );
+
+	rect_t
+	toRect() const;
+};
+
+//! Texture manager statistics (see cubr_texmgr.h)
+// Copper members: textures, used, bytes, budget, hits, misses, evictions
+struct TextureStats {
+	Cu::Integer  textures;
+	Cu::Integer  used;
+	Cu::Integer  bytes;
+	Cu::Integer  budget;
+	Cu::Integer  hits;
+	Cu::Integer  misses;
+	Cu::Integer  evictions;
+
+	static const MarshalField<TextureStats>*
+	fields( Cu::UInteger& );
+
+	static TextureStats
+	from( const TextureManager& );
+};
+
+//! Event queue statistics (see cubr_evqueue.h)
+// Copper members: depth, peak_depth, delivered, carried, pump_time, max_latency, average_latency
+struct EventStats {
+	Cu::Integer  depth;
+	Cu::Integer  peakDepth;
+	Cu::Integer  delivered;
+	Cu::Integer  carried;
+	Cu::Integer  pumpTime;
+	Cu::Integer  maxLatency;
+	Cu::Integer  averageLatency;
+
+	static const MarshalField<EventStats>*
+	fields( Cu::UInteger& );
+
+	static EventStats
+	from( const GUIEventQueue& );
+};
+
+}
+
+#endif
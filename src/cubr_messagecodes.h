@@ -30,6 +30,45 @@ struct CuBridgeMessageCode {
 		//! Warning - Image set pixel missing color function
 		ImageSetPixelMissingColor,
 
+		//! Warning - Argument is not a geometry object or does not have the requested member
+		GeometryUnknownMember,
+
+		//! Warning - Float array index is negative or not less than the array size
+		FloatArrayIndexOutOfBounds,
+
+		//! Warning - Pixel buffer index is negative or not less than the buffer size
+		PixelBufferIndexOutOfBounds,
+
+		//! Warning - Image color format is not supported by the bulk pixel functions (see cubr_pixfmt.h)
+		ImageColorFormatNotSupported,
+
+		//! Warning - Image job kernel name is not known
+		ImageJobUnknownKernel,
+
+		//! Warning - Texture is not the same size as the image it is updated from
+		TextureSizeMismatch,
+
+		//! Warning - Texture could not be locked or its memory cannot be viewed as an image
+		TextureLockFailed,
+
+		//! Warning - Image for the atlas could not be loaded
+		AtlasImageNotLoaded,
+
+		//! Warning - Atlas has no room left for the image
+		AtlasFull,
+
+		//! Warning - GUI event does not have the requested member
+		GUIEventUnknownMember,
+
+		//! Warning - GUI event type name is not known (see GUIEventTypeNames in cubr_irrevent_translate.h)
+		GUIEventUnknownType,
+
+		//! Warning - Event coalescing policy name is not known (see cubr_evqueue.h)
+		EventCoalescingUnknown,
+
+		//! Warning - Atlas is larger than the largest texture the video driver can make
+		AtlasTooLarge,
+
 		//! A useful constant
 		LAST
 	};
@@ -0,0 +1,122 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_pixfmt.h"
+#include "cubr_imgkern.h"
+#include <cstring>
+
+namespace cubr {
+
+using irr::u8;
+using irr::u16;
+using irr::u32;
+using namespace irr::video;
+
+bool
+isPackableColorFormat( ECOLOR_FORMAT  format ) {
+	switch( format ) {
+	case ECF_A8R8G8B8:
+	case ECF_R8G8B8:
+	case ECF_A1R5G5B5:
+	case ECF_R5G6B5:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void
+readPixelsARGB( const void*  src, ECOLOR_FORMAT  format, u32*  dst, u32  count ) {
+	u32  i = 0;
+	switch( format ) {
+	case ECF_A8R8G8B8:
+		std::memcpy(dst, src, count * 4);
+		break;
+
+	case ECF_R8G8B8: {
+		const u8*  s = (const u8*)src;
+		for (; i < count; ++i, s += 3)
+			dst[i] = 0xff000000 | ((u32)s[0] << 16) | ((u32)s[1] << 8) | (u32)s[2];
+		} break;
+
+	case ECF_A1R5G5B5: {
+		const u16*  s = (const u16*)src;
+		for (; i < count; ++i)
+			dst[i] = A1R5G5B5toA8R8G8B8(s[i]);
+		} break;
+
+	case ECF_R5G6B5: {
+		const u16*  s = (const u16*)src;
+		for (; i < count; ++i)
+			dst[i] = R5G6B5toA8R8G8B8(s[i]);
+		} break;
+
+	default:
+		break;
+	}
+}
+
+void
+writePixelsARGB( const u32*  src, ECOLOR_FORMAT  format, void*  dst, u32  count ) {
+	u32  i = 0;
+	switch( format ) {
+	case ECF_A8R8G8B8:
+		std::memcpy(dst, src, count * 4);
+		break;
+
+	case ECF_R8G8B8: {
+		u8*  d = (u8*)dst;
+		for (; i < count; ++i, d += 3) {
+			d[0] = (u8)(src[i] >> 16);
+			d[1] = (u8)(src[i] >> 8);
+			d[2] = (u8)src[i];
+		}
+		} break;
+
+	case ECF_A1R5G5B5: {
+		u16*  d = (u16*)dst;
+		for (; i < count; ++i)
+			d[i] = A8R8G8B8toA1R5G5B5(src[i]);
+		} break;
+
+	case ECF_R5G6B5: {
+		u16*  d = (u16*)dst;
+		for (; i < count; ++i)
+			d[i] = A8R8G8B8toR5G6B5(src[i]);
+		} break;
+
+	default:
+		break;
+	}
+}
+
+void
+fillPixelsARGB( u32  color, ECOLOR_FORMAT  format, void*  dst, u32  count ) {
+	u32  i = 0;
+	switch( format ) {
+	case ECF_A8R8G8B8:
+		fillSpanARGB( (u32*)dst, count, color );
+		break;
+
+	case ECF_R8G8B8: {
+		u8*  d = (u8*)dst;
+		for (; i < count; ++i, d += 3) {
+			d[0] = (u8)(color >> 16);
+			d[1] = (u8)(color >> 8);
+			d[2] = (u8)color;
+		}
+		} break;
+
+	case ECF_A1R5G5B5:
+	case ECF_R5G6B5: {
+		const u16  c = format == ECF_A1R5G5B5 ? A8R8G8B8toA1R5G5B5(color) : A8R8G8B8toR5G6B5(color);
+		u16*  d = (u16*)dst;
+		for (; i < count; ++i)
+			d[i] = c;
+		} break;
+
+	default:
+		break;
+	}
+}
+
+}
@@ -0,0 +1,34 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_PIXFMT_H_
+#define _CUBR_PIXFMT_H_
+
+#include <irrTypes.h> // from Irrlicht
+#include <SColor.h> // from Irrlicht
+
+namespace cubr {
+
+//! Pixel format conversion
+/*
+	Converts spans of pixels between an image color format and packed A8R8G8B8 (the layout of SColor::color).
+	Supported formats are A8R8G8B8, R8G8B8, A1R5G5B5 and R5G6B5.
+*/
+
+bool
+isPackableColorFormat( irr::video::ECOLOR_FORMAT );
+
+//! Reads count pixels of the given format into dst as A8R8G8B8.
+void
+readPixelsARGB( const void*  src, irr::video::ECOLOR_FORMAT, irr::u32*  dst, irr::u32  count );
+
+//! Writes count A8R8G8B8 pixels from src to dst in the given format.
+void
+writePixelsARGB( const irr::u32*  src, irr::video::ECOLOR_FORMAT, void*  dst, irr::u32  count );
+
+//! Writes the A8R8G8B8 color to count pixels of the given format.
+void
+fillPixelsARGB( irr::u32  color, irr::video::ECOLOR_FORMAT, void*  dst, irr::u32  count );
+
+}
+
+#endif
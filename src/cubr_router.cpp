@@ -0,0 +1,231 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_router.h"
+
+namespace cubr {
+
+using namespace irr::gui;
+
+EventRouter::EventRouter( Cu::Engine&  e )
+	: engine(e)
+	, next(REAL_NULL)
+	, eventQueue(REAL_NULL)
+	, routes()
+	, slots()
+	, args()
+	, eventsSincePrune(0)
+{
+	rebuildSlots();
+}
+
+EventRouter::~EventRouter() {
+	irr::u32  i = 0;
+	irr::u32  t;
+	for (; i < routes.size(); ++i) {
+		for (t=0; t < EGET_COUNT; ++t) {
+			if ( routes[i].callbacks[t] ) {
+				routes[i].callbacks[t]->disown(this);
+				routes[i].callbacks[t]->deref();
+			}
+		}
+		routes[i].element->drop();
+	}
+}
+
+void
+EventRouter::setNext( irr::IEventReceiver*  receiver ) {
+	next = receiver;
+}
+
+irr::IEventReceiver*
+EventRouter::getNext() const {
+	return next;
+}
+
+void
+EventRouter::setEventQueue( GUIEventQueue*  queue ) {
+	eventQueue = queue;
+}
+
+void
+EventRouter::setCallback( gui_element_t*  element, EGUI_EVENT_TYPE  type, Cu::FunctionObject*  callback ) {
+	Route*  route;
+	Route  newRoute;
+	Cu::FunctionObject*  oldCallback;
+	irr::u32  t = 0;
+
+	if ( ! element || type >= EGET_COUNT )
+		return;
+
+	route = find(element);
+	if ( ! route ) {
+		if ( ! callback )
+			return;
+
+		// New entries are the only ones that grow the table, so it is a good time to drop old ones
+		prune();
+		newRoute.element = element;
+		for (; t < EGET_COUNT; ++t)
+			newRoute.callbacks[t] = REAL_NULL;
+		element->grab();
+		routes.push_back(newRoute);
+		rebuildSlots();
+		route = &(routes.getLast());
+	}
+
+	oldCallback = route->callbacks[type];
+	if ( callback ) {
+		callback->ref();
+		callback->changeOwnerTo(this);
+	}
+	route->callbacks[type] = callback;
+	if ( oldCallback ) {
+		// The same function may still be the callback of other elements or event types
+		if ( ! owns(oldCallback) )
+			oldCallback->disown(this);
+		oldCallback->deref();
+	}
+}
+
+irr::u32
+EventRouter::prune() {
+	irr::u32  kept = 0;
+	irr::u32  i = 0;
+
+	eventsSincePrune = 0;
+	for (; i < routes.size(); ++i) {
+		// Only the router's grab is left
+		if ( routes[i].element->getReferenceCount() <= 1 ) {
+			releaseRoute(routes[i]);
+			continue;
+		}
+		if ( kept != i )
+			routes[kept] = routes[i];
+		++kept;
+	}
+	if ( kept == routes.size() )
+		return 0;
+
+	i = routes.size() - kept;
+	routes.set_used(kept);
+	rebuildSlots();
+	return i;
+}
+
+irr::u32
+EventRouter::getElementCount() const {
+	return routes.size();
+}
+
+bool
+EventRouter::OnEvent( const irr::SEvent&  event ) {
+	Route*  route;
+	Cu::FunctionObject*  callback;
+	Cu::Object*  returnObject;
+	bool  handled = false;
+
+	// Other events, such as log text from image decoding, may come from other threads and only pass through
+	if ( event.EventType == irr::EET_GUI_EVENT
+		&& event.GUIEvent.EventType < EGET_COUNT
+		&& routes.size() > 0 )
+	{
+		if ( ++eventsSincePrune >= PRUNE_INTERVAL )
+			prune();
+
+		route = find(event.GUIEvent.Caller);
+		callback = route ? route->callbacks[event.GUIEvent.EventType] : REAL_NULL;
+
+		if ( callback && ! ( eventQueue && eventQueue->enqueue(callback, event.GUIEvent, true) ) ) {
+			// Kept alive in case the callback replaces itself
+			callback->ref();
+			if ( engine.runFunctionObject( callback, args.set(event.GUIEvent) ) != Cu::EngineResult::Error ) {
+				returnObject = engine.getLastObject();
+				if ( Cu::isBoolObject(*returnObject) )
+					handled = ((Cu::BoolObject*)returnObject)->getValue();
+			}
+			callback->deref();
+			if ( handled )
+				return true;
+		}
+	}
+	return next ? next->OnEvent(event) : false;
+}
+
+bool
+EventRouter::owns( Cu::FunctionObject*  container ) const {
+	irr::u32  i = 0;
+	irr::u32  t;
+
+	if ( isNull(container) )
+		return false;
+
+	for (; i < routes.size(); ++i) {
+		for (t=0; t < EGET_COUNT; ++t) {
+			if ( routes[i].callbacks[t] == container )
+				return true;
+		}
+	}
+	return false;
+}
+
+irr::u32
+EventRouter::hash( const gui_element_t*  element ) {
+	// Elements are aligned, so the low bits are dropped
+	const irr::u64  p = (irr::u64)(size_t)element >> 4;
+	const irr::u32  h = (irr::u32)(p ^ (p >> 32)) * 2654435761u;
+	return h ^ (h >> 16);
+}
+
+EventRouter::Route*
+EventRouter::find( const gui_element_t*  element ) {
+	const irr::u32  mask = slots.size() - 1;
+	irr::u32  i = hash(element) & mask;
+
+	for (; slots[i] >= 0; i = (i + 1) & mask) {
+		if ( routes[ slots[i] ].element == element )
+			return &(routes[ slots[i] ]);
+	}
+	return REAL_NULL;
+}
+
+void
+EventRouter::rebuildSlots() {
+	irr::u32  capacity = 16;
+	irr::u32  mask;
+	irr::u32  i = 0;
+	irr::u32  s;
+
+	// At most half full
+	while ( capacity < routes.size() * 2 )
+		capacity <<= 1;
+	slots.set_used(capacity);
+	for (; i < capacity; ++i)
+		slots[i] = -1;
+
+	mask = capacity - 1;
+	for (i=0; i < routes.size(); ++i) {
+		s = hash(routes[i].element) & mask;
+		while ( slots[s] >= 0 )
+			s = (s + 1) & mask;
+		slots[s] = (irr::s32)i;
+	}
+}
+
+void
+EventRouter::releaseRoute( Route&  route ) {
+	Cu::FunctionObject*  callback;
+	irr::u32  t = 0;
+
+	for (; t < EGET_COUNT; ++t) {
+		callback = route.callbacks[t];
+		if ( ! callback )
+			continue;
+		route.callbacks[t] = REAL_NULL;
+		if ( ! owns(callback) )
+			callback->disown(this);
+		callback->deref();
+	}
+	route.element->drop();
+}
+
+}
@@ -0,0 +1,92 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_ROUTER_H_
+#define _CUBR_ROUTER_H_
+
+#include <IEventReceiver.h> // from Irrlicht
+#include <irrArray.h>
+#include <Copper.h>
+#include "cubr_defs.h"
+#include "cubr_event.h"
+
+namespace cubr {
+
+//! Event Router
+/*
+	Runs Copper callbacks for the GUI events of individual elements without adding watcher elements
+	to the GUI tree. The callbacks are found in a hash table by the element that sent the event
+	(SGUIEvent::Caller), so dispatching does not depend on the number of elements.
+	Callbacks are given the caller ID, the element ID and a cubrguievent, as with EventHandler,
+	and may return true to mark the event as handled. Events that are not handled go to the next receiver.
+	Each element with callbacks is grabbed so that the table never holds a removed element.
+	Once the router holds the only reference (the element was removed from the GUI and no script keeps it),
+	prune() drops its entry. prune() is run when an element is given its first callback, every PRUNE_INTERVAL GUI
+	events and by CuBridge after gui_remove_child() and gui_remove_children(), so a removed element may be
+	kept until one of those happens.
+*/
+class EventRouter : public irr::IEventReceiver, public Cu::Owner {
+	struct Route {
+		gui_element_t*  element;
+		Cu::FunctionObject*  callbacks[irr::gui::EGET_COUNT];
+	};
+
+	Cu::Engine&  engine;
+	irr::IEventReceiver*  next;
+	GUIEventQueue*  eventQueue;
+	irr::core::array<Route>  routes;
+	irr::core::array<irr::s32>  slots; // Open-addressing table of route indices, -1 for empty. Rebuilt by prune().
+	EventHandler::ArgFrame  args;
+	irr::u32  eventsSincePrune;
+
+public:
+	enum { PRUNE_INTERVAL = 256 };
+
+	EventRouter( Cu::Engine& );
+
+	~EventRouter();
+
+	//! Receiver of the events not handled by the router
+	void
+	setNext( irr::IEventReceiver* );
+
+	irr::IEventReceiver*
+	getNext() const;
+
+	//! Events whose coalescing policy is not immediate are queued here rather than run
+	void
+	setEventQueue( GUIEventQueue* );
+
+	//! Sets the callback of the element for the given event type. A null callback removes it.
+	void
+	setCallback( gui_element_t*, irr::gui::EGUI_EVENT_TYPE, Cu::FunctionObject* );
+
+	//! Drops the entries of the elements that are no longer in use and returns the number dropped
+	irr::u32
+	prune();
+
+	irr::u32
+	getElementCount() const;
+
+	virtual bool
+	OnEvent( const irr::SEvent& );
+
+	virtual bool
+	owns( Cu::FunctionObject* ) const;
+
+protected:
+	static irr::u32
+	hash( const gui_element_t* );
+
+	Route*
+	find( const gui_element_t* );
+
+	void
+	rebuildSlots();
+
+	void
+	releaseRoute( Route& );
+};
+
+}
+
+#endif
@@ -0,0 +1,497 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_setattr.h"
+#include "cubr_attr.h"
+#include <IGUIButton.h> // from Irrlicht
+#include <IGUICheckBox.h>
+#include <IGUIComboBox.h>
+#include <IGUIEditBox.h>
+#include <IGUIImage.h>
+#include <IGUIListBox.h>
+#include <IGUIScrollBar.h>
+#include <IGUISpinBox.h>
+#include <IGUIStaticText.h>
+#include <IGUITabControl.h>
+#include <IGUIWindow.h>
+
+namespace cubr {
+
+using irr::gui::IGUIButton;
+using irr::gui::IGUICheckBox;
+using irr::gui::IGUIComboBox;
+using irr::gui::IGUIEditBox;
+using irr::gui::IGUIImage;
+using irr::gui::IGUIListBox;
+using irr::gui::IGUIScrollBar;
+using irr::gui::IGUISpinBox;
+using irr::gui::IGUIStaticText;
+using irr::gui::IGUITab;
+using irr::gui::IGUITabControl;
+using irr::gui::IGUIWindow;
+
+// Each setter passes the current value as the default so that a member of the wrong type leaves
+// the element unchanged.
+
+//----- Common to all elements
+
+static bool
+setElementText( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setText( in.getAttributeAsStringW(name, core::stringw(e->getText())).c_str() );
+	return true;
+}
+
+static bool
+setElementToolTip( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setToolTipText( in.getAttributeAsStringW(name, e->getToolTipText()).c_str() );
+	return true;
+}
+
+static bool
+setElementName( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setName( in.getAttributeAsString(name, core::stringc(e->getName())) );
+	return true;
+}
+
+static bool
+setElementId( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setID( in.getAttributeAsInt(name, e->getID()) );
+	return true;
+}
+
+static bool
+setElementRect( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setRelativePosition( in.getAttributeAsRect(name, e->getRelativePosition()) );
+	return true;
+}
+
+static bool
+setElementVisible( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setVisible( in.getAttributeAsBool(name, e->isVisible()) );
+	return true;
+}
+
+static bool
+setElementEnabled( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setEnabled( in.getAttributeAsBool(name, e->isEnabled()) );
+	return true;
+}
+
+static bool
+setElementNoClip( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setNotClipped( in.getAttributeAsBool(name, e->isNotClipped()) );
+	return true;
+}
+
+static bool
+setElementTabStop( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setTabStop( in.getAttributeAsBool(name, e->isTabStop()) );
+	return true;
+}
+
+static bool
+setElementTabGroup( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setTabGroup( in.getAttributeAsBool(name, e->isTabGroup()) );
+	return true;
+}
+
+static bool
+setElementTabOrder( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	e->setTabOrder( in.getAttributeAsInt(name, e->getTabOrder()) );
+	return true;
+}
+
+//----- Button
+
+static bool
+setButtonImage( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	texture_t*  texture = in.getAttributeAsTexture(name, 0);
+	if ( ! texture )
+		return false;
+	static_cast<IGUIButton*>(e)->setImage(texture);
+	return true;
+}
+
+static bool
+setButtonPressedImage( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	texture_t*  texture = in.getAttributeAsTexture(name, 0);
+	if ( ! texture )
+		return false;
+	static_cast<IGUIButton*>(e)->setPressedImage(texture);
+	return true;
+}
+
+static bool
+setButtonPressed( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIButton*  button = static_cast<IGUIButton*>(e);
+	button->setPressed( in.getAttributeAsBool(name, button->isPressed()) );
+	return true;
+}
+
+static bool
+setButtonPushButton( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIButton*  button = static_cast<IGUIButton*>(e);
+	button->setIsPushButton( in.getAttributeAsBool(name, button->isPushButton()) );
+	return true;
+}
+
+static bool
+setButtonBorder( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIButton*  button = static_cast<IGUIButton*>(e);
+	button->setDrawBorder( in.getAttributeAsBool(name, button->isDrawingBorder()) );
+	return true;
+}
+
+static bool
+setButtonUseAlphaChannel( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIButton*  button = static_cast<IGUIButton*>(e);
+	button->setUseAlphaChannel( in.getAttributeAsBool(name, button->isAlphaChannelUsed()) );
+	return true;
+}
+
+static bool
+setButtonScaleImage( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIButton*  button = static_cast<IGUIButton*>(e);
+	button->setScaleImage( in.getAttributeAsBool(name, button->isScalingImage()) );
+	return true;
+}
+
+//----- Check box
+
+static bool
+setCheckBoxChecked( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUICheckBox*  box = static_cast<IGUICheckBox*>(e);
+	box->setChecked( in.getAttributeAsBool(name, box->isChecked()) );
+	return true;
+}
+
+//----- Scroll bar
+
+static bool
+setScrollBarPos( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIScrollBar*  bar = static_cast<IGUIScrollBar*>(e);
+	bar->setPos( in.getAttributeAsInt(name, bar->getPos()) );
+	return true;
+}
+
+static bool
+setScrollBarMin( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIScrollBar*  bar = static_cast<IGUIScrollBar*>(e);
+	bar->setMin( in.getAttributeAsInt(name, bar->getMin()) );
+	return true;
+}
+
+static bool
+setScrollBarMax( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIScrollBar*  bar = static_cast<IGUIScrollBar*>(e);
+	bar->setMax( in.getAttributeAsInt(name, bar->getMax()) );
+	return true;
+}
+
+static bool
+setScrollBarSmallStep( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIScrollBar*  bar = static_cast<IGUIScrollBar*>(e);
+	bar->setSmallStep( in.getAttributeAsInt(name, bar->getSmallStep()) );
+	return true;
+}
+
+static bool
+setScrollBarLargeStep( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIScrollBar*  bar = static_cast<IGUIScrollBar*>(e);
+	bar->setLargeStep( in.getAttributeAsInt(name, bar->getLargeStep()) );
+	return true;
+}
+
+//----- Image
+
+static bool
+setImageTexture( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	texture_t*  texture = in.getAttributeAsTexture(name, 0);
+	if ( ! texture )
+		return false;
+	static_cast<IGUIImage*>(e)->setImage(texture);
+	return true;
+}
+
+static bool
+setImageUseAlphaChannel( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIImage*  image = static_cast<IGUIImage*>(e);
+	image->setUseAlphaChannel( in.getAttributeAsBool(name, image->isAlphaChannelUsed()) );
+	return true;
+}
+
+static bool
+setImageScaleImage( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIImage*  image = static_cast<IGUIImage*>(e);
+	image->setScaleImage( in.getAttributeAsBool(name, image->isImageScaled()) );
+	return true;
+}
+
+//----- Static text
+
+static bool
+setStaticTextOverrideColor( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIStaticText*  text = static_cast<IGUIStaticText*>(e);
+	text->setOverrideColor( in.getAttributeAsColor(name, text->getOverrideColor()) );
+	return true;
+}
+
+static bool
+setStaticTextBackgroundColor( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIStaticText*  text = static_cast<IGUIStaticText*>(e);
+	text->setBackgroundColor( in.getAttributeAsColor(name, text->getBackgroundColor()) );
+	return true;
+}
+
+static bool
+setStaticTextBorder( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIStaticText*  text = static_cast<IGUIStaticText*>(e);
+	text->setDrawBorder( in.getAttributeAsBool(name, text->isDrawBorderEnabled()) );
+	return true;
+}
+
+static bool
+setStaticTextBackground( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIStaticText*  text = static_cast<IGUIStaticText*>(e);
+	text->setDrawBackground( in.getAttributeAsBool(name, text->isDrawBackgroundEnabled()) );
+	return true;
+}
+
+static bool
+setStaticTextWordWrap( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIStaticText*  text = static_cast<IGUIStaticText*>(e);
+	text->setWordWrap( in.getAttributeAsBool(name, text->isWordWrapEnabled()) );
+	return true;
+}
+
+//----- Edit box
+
+static bool
+setEditBoxOverrideColor( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIEditBox*  box = static_cast<IGUIEditBox*>(e);
+	box->setOverrideColor( in.getAttributeAsColor(name, box->getOverrideColor()) );
+	return true;
+}
+
+static bool
+setEditBoxMax( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIEditBox*  box = static_cast<IGUIEditBox*>(e);
+	// Irrlicht keeps the maximum as an int attribute (see CGUIEditBox::deserializeAttributes())
+	box->setMax( (u32) in.getAttributeAsInt(name, (s32)box->getMax()) );
+	return true;
+}
+
+static bool
+setEditBoxWordWrap( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIEditBox*  box = static_cast<IGUIEditBox*>(e);
+	box->setWordWrap( in.getAttributeAsBool(name, box->isWordWrapEnabled()) );
+	return true;
+}
+
+static bool
+setEditBoxMultiLine( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIEditBox*  box = static_cast<IGUIEditBox*>(e);
+	box->setMultiLine( in.getAttributeAsBool(name, box->isMultiLineEnabled()) );
+	return true;
+}
+
+static bool
+setEditBoxAutoScroll( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIEditBox*  box = static_cast<IGUIEditBox*>(e);
+	box->setAutoScroll( in.getAttributeAsBool(name, box->isAutoScrollEnabled()) );
+	return true;
+}
+
+static bool
+setEditBoxPasswordBox( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIEditBox*  box = static_cast<IGUIEditBox*>(e);
+	box->setPasswordBox( in.getAttributeAsBool(name, box->isPasswordBox()) );
+	return true;
+}
+
+//----- Combo box, list box, spin box
+
+static bool
+setComboBoxSelected( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIComboBox*  box = static_cast<IGUIComboBox*>(e);
+	box->setSelected( in.getAttributeAsInt(name, box->getSelected()) );
+	return true;
+}
+
+static bool
+setListBoxSelected( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIListBox*  box = static_cast<IGUIListBox*>(e);
+	box->setSelected( in.getAttributeAsInt(name, box->getSelected()) );
+	return true;
+}
+
+static bool
+setSpinBoxValue( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUISpinBox*  box = static_cast<IGUISpinBox*>(e);
+	box->setValue( in.getAttributeAsFloat(name, box->getValue()) );
+	return true;
+}
+
+//----- Tabs
+
+static bool
+setTabControlActiveTab( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUITabControl*  control = static_cast<IGUITabControl*>(e);
+	return control->setActiveTab( in.getAttributeAsInt(name, control->getActiveTab()) );
+}
+
+static bool
+setTabBackColor( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUITab*  tab = static_cast<IGUITab*>(e);
+	tab->setBackgroundColor( in.getAttributeAsColor(name, tab->getBackgroundColor()) );
+	return true;
+}
+
+static bool
+setTabTextColor( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUITab*  tab = static_cast<IGUITab*>(e);
+	tab->setTextColor( in.getAttributeAsColor(name, tab->getTextColor()) );
+	return true;
+}
+
+static bool
+setTabDrawBackground( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUITab*  tab = static_cast<IGUITab*>(e);
+	tab->setDrawBackground( in.getAttributeAsBool(name, tab->isDrawingBackground()) );
+	return true;
+}
+
+//----- Window
+
+static bool
+setWindowDrawBackground( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIWindow*  window = static_cast<IGUIWindow*>(e);
+	window->setDrawBackground( in.getAttributeAsBool(name, window->getDrawBackground()) );
+	return true;
+}
+
+static bool
+setWindowDrawTitlebar( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIWindow*  window = static_cast<IGUIWindow*>(e);
+	window->setDrawTitlebar( in.getAttributeAsBool(name, window->getDrawTitlebar()) );
+	return true;
+}
+
+static bool
+setWindowDraggable( gui_element_t* e, AttributeSource& in, const c8* name ) {
+	IGUIWindow*  window = static_cast<IGUIWindow*>(e);
+	window->setDraggable( in.getAttributeAsBool(name, window->isDraggable()) );
+	return true;
+}
+
+//-----
+
+AttributeSetterTable::AttributeSetterTable()
+	: customTypes()
+{
+	addBuiltins();
+}
+
+void
+AttributeSetterTable::add( irr::gui::EGUI_ELEMENT_TYPE  type, const c8*  name, AttributeSetter  setter ) {
+	getSetters(type, true)->insert(name, setter);
+}
+
+AttributeSetter
+AttributeSetterTable::find( irr::gui::EGUI_ELEMENT_TYPE  type, const c8*  name ) const {
+	const setter_map_t*  setters = const_cast<AttributeSetterTable*>(this)->getSetters(type, false);
+	const AttributeSetter*  setter;
+	if ( setters ) {
+		setter = setters->find(name);
+		if ( setter )
+			return *setter;
+	}
+	setter = builtinTypes[irr::gui::EGUIET_ELEMENT].find(name);
+	return setter ? *setter : 0;
+}
+
+AttributeSetterTable::setter_map_t*
+AttributeSetterTable::getSetters( irr::gui::EGUI_ELEMENT_TYPE  type, bool  create ) {
+	if ( (u32)type < (u32)irr::gui::EGUIET_COUNT )
+		return &(builtinTypes[type]);
+
+	u32  i = 0;
+	for (; i < customTypes.size(); ++i) {
+		if ( customTypes[i].type == (s32)type )
+			return &(customTypes[i].setters);
+	}
+	if ( ! create )
+		return 0;
+
+	customTypes.push_back( CustomType() );
+	customTypes.getLast().type = (s32)type;
+	return &(customTypes.getLast().setters);
+}
+
+void
+AttributeSetterTable::addBuiltins() {
+	using namespace irr::gui;
+
+	// Names match those used by the serializeAttributes() methods of Irrlicht, plus a few aliases.
+	add(EGUIET_ELEMENT, "Caption", &setElementText);
+	add(EGUIET_ELEMENT, "Text", &setElementText);
+	add(EGUIET_ELEMENT, "ToolTip", &setElementToolTip);
+	add(EGUIET_ELEMENT, "Name", &setElementName);
+	add(EGUIET_ELEMENT, "Id", &setElementId);
+	add(EGUIET_ELEMENT, "Rect", &setElementRect);
+	add(EGUIET_ELEMENT, "Visible", &setElementVisible);
+	add(EGUIET_ELEMENT, "Enabled", &setElementEnabled);
+	add(EGUIET_ELEMENT, "NoClip", &setElementNoClip);
+	add(EGUIET_ELEMENT, "TabStop", &setElementTabStop);
+	add(EGUIET_ELEMENT, "TabGroup", &setElementTabGroup);
+	add(EGUIET_ELEMENT, "TabOrder", &setElementTabOrder);
+
+	add(EGUIET_BUTTON, "Image", &setButtonImage);
+	add(EGUIET_BUTTON, "PressedImage", &setButtonPressedImage);
+	add(EGUIET_BUTTON, "Pressed", &setButtonPressed);
+	add(EGUIET_BUTTON, "PushButton", &setButtonPushButton);
+	add(EGUIET_BUTTON, "Border", &setButtonBorder);
+	add(EGUIET_BUTTON, "UseAlphaChannel", &setButtonUseAlphaChannel);
+	add(EGUIET_BUTTON, "ScaleImage", &setButtonScaleImage);
+
+	add(EGUIET_CHECK_BOX, "Checked", &setCheckBoxChecked);
+
+	add(EGUIET_SCROLL_BAR, "Value", &setScrollBarPos);
+	add(EGUIET_SCROLL_BAR, "Pos", &setScrollBarPos);
+	add(EGUIET_SCROLL_BAR, "Min", &setScrollBarMin);
+	add(EGUIET_SCROLL_BAR, "Max", &setScrollBarMax);
+	add(EGUIET_SCROLL_BAR, "SmallStep", &setScrollBarSmallStep);
+	add(EGUIET_SCROLL_BAR, "LargeStep", &setScrollBarLargeStep);
+
+	add(EGUIET_IMAGE, "Texture", &setImageTexture);
+	add(EGUIET_IMAGE, "Image", &setImageTexture);
+	add(EGUIET_IMAGE, "UseAlphaChannel", &setImageUseAlphaChannel);
+	add(EGUIET_IMAGE, "ScaleImage", &setImageScaleImage);
+
+	add(EGUIET_STATIC_TEXT, "OverrideColor", &setStaticTextOverrideColor);
+	add(EGUIET_STATIC_TEXT, "BackgroundColor", &setStaticTextBackgroundColor);
+	add(EGUIET_STATIC_TEXT, "Border", &setStaticTextBorder);
+	add(EGUIET_STATIC_TEXT, "Background", &setStaticTextBackground);
+	add(EGUIET_STATIC_TEXT, "WordWrap", &setStaticTextWordWrap);
+
+	add(EGUIET_EDIT_BOX, "OverrideColor", &setEditBoxOverrideColor);
+	add(EGUIET_EDIT_BOX, "MaxChars", &setEditBoxMax);
+	add(EGUIET_EDIT_BOX, "WordWrap", &setEditBoxWordWrap);
+	add(EGUIET_EDIT_BOX, "MultiLine", &setEditBoxMultiLine);
+	add(EGUIET_EDIT_BOX, "AutoScroll", &setEditBoxAutoScroll);
+	add(EGUIET_EDIT_BOX, "PasswordBox", &setEditBoxPasswordBox);
+
+	add(EGUIET_COMBO_BOX, "Selected", &setComboBoxSelected);
+	add(EGUIET_LIST_BOX, "Selected", &setListBoxSelected);
+	add(EGUIET_SPIN_BOX, "Value", &setSpinBoxValue);
+
+	add(EGUIET_TAB_CONTROL, "ActiveTab", &setTabControlActiveTab);
+	add(EGUIET_TAB, "TabBackColor", &setTabBackColor);
+	add(EGUIET_TAB, "TabTextColor", &setTabTextColor);
+	add(EGUIET_TAB, "FillBackground", &setTabDrawBackground);
+
+	add(EGUIET_WINDOW, "DrawBackground", &setWindowDrawBackground);
+	add(EGUIET_WINDOW, "DrawTitlebar", &setWindowDrawTitlebar);
+	add(EGUIET_WINDOW, "IsDraggable", &setWindowDraggable);
+}
+
+}
@@ -0,0 +1,69 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_SET_ATTRIBUTE_H_
+#define _CUBR_SET_ATTRIBUTE_H_
+
+#include <EGUIElementTypes.h> // from Irrlicht
+#include <irrArray.h> // from Irrlicht
+#include "cubr_defs.h"
+#include "cubr_strmap.h"
+
+namespace cubr {
+
+class AttributeSource;
+
+//! Attribute Setter
+/*
+	Reads the attribute of the given name from the source and applies it to the element via the
+	element's own typed setter.
+	The element is guaranteed to be of the type the setter was registered for.
+	Return false if the value could not be applied.
+*/
+typedef bool (*AttributeSetter)( gui_element_t*, AttributeSource&, const irr::c8* );
+
+//! Attribute Setter Table
+/*
+	Maps attribute names to setters for each GUI element type so that a handful of attributes can be
+	changed without deserializeAttributes() re-reading every attribute the element supports.
+	Setters registered for EGUIET_ELEMENT apply to every element type.
+	Custom element types (whose type value is not less than EGUIET_COUNT) can be added too.
+*/
+class AttributeSetterTable {
+	typedef  StringMap<AttributeSetter>  setter_map_t;
+
+	struct CustomType {
+		irr::s32  type;
+		setter_map_t  setters;
+
+		CustomType()
+			: type(irr::gui::EGUIET_COUNT)
+			, setters(8)
+		{}
+	};
+
+	setter_map_t  builtinTypes[irr::gui::EGUIET_COUNT];
+	irr::core::array<CustomType>  customTypes;
+
+public:
+	//! Creates the table with setters for the stock Irrlicht elements.
+	AttributeSetterTable();
+
+	void
+	add( irr::gui::EGUI_ELEMENT_TYPE, const irr::c8*, AttributeSetter );
+
+	//! Returns the setter for the attribute of the given element type or null if there is none.
+	// Falls back to the setters common to all elements.
+	AttributeSetter
+	find( irr::gui::EGUI_ELEMENT_TYPE, const irr::c8* ) const;
+
+protected:
+	setter_map_t*
+	getSetters( irr::gui::EGUI_ELEMENT_TYPE, bool create );
+
+	void
+	addBuiltins();
+};
+
+}
+
+#endif
@@ -0,0 +1,163 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_STRMAP_H_
+#define _CUBR_STRMAP_H_
+
+#include <irrTypes.h> // from Irrlicht
+#include <irrArray.h> // from Irrlicht
+#include <Strings.h> // from Copper
+
+namespace cubr {
+
+//! String Map
+/*
+	Open-addressing hash table keyed by byte strings.
+	Lookups take a plain const char* so that callers (such as the IAttributes interface, which
+	only ever hands us const c8*) never need to construct a util::String just to search.
+	The key is copied once, upon insertion.
+	Entries cannot be removed individually. Use clear() to empty the table.
+*/
+template<class T>
+class StringMap {
+public:
+	struct Entry {
+		util::String  name;
+		irr::u32  hash;
+		bool  used;
+		T  value;
+
+		Entry()
+			: name()
+			, hash(0)
+			, used(false)
+			, value()
+		{}
+	};
+
+private:
+	irr::core::array<Entry>  table;
+	irr::u32  count;
+
+public:
+	StringMap( irr::u32  initialCapacity = 16 )
+		: table()
+		, count(0)
+	{
+		irr::u32  capacity = 8;
+		while ( capacity < initialCapacity )
+			capacity <<= 1;
+		allocate(capacity);
+	}
+
+	//! FNV-1a
+	static irr::u32
+	hash( const irr::c8*  key ) {
+		irr::u32  h = 2166136261u;
+		for (; *key; ++key) {
+			h ^= (irr::u8)(*key);
+			h *= 16777619u;
+		}
+		return h;
+	}
+
+	//! Returns a pointer to the value stored for the given key or null if there is none.
+	T*
+	find( const irr::c8*  key ) {
+		const irr::u32  h = hash(key);
+		const irr::u32  mask = table.size() - 1;
+		irr::u32  i = h & mask;
+		for (; table[i].used; i = (i + 1) & mask) {
+			if ( table[i].hash == h && table[i].name.equals(key) )
+				return &(table[i].value);
+		}
+		return 0;
+	}
+
+	const T*
+	find( const irr::c8*  key ) const {
+		return const_cast<StringMap<T>*>(this)->find(key);
+	}
+
+	//! Stores the value for the given key, replacing any existing value.
+	//! Returns a reference to the stored value.
+	T&
+	insert( const irr::c8*  key, const T&  value ) {
+		if ( (count + 1) * 2 > table.size() )
+			grow();
+
+		const irr::u32  h = hash(key);
+		const irr::u32  mask = table.size() - 1;
+		irr::u32  i = h & mask;
+		for (; table[i].used; i = (i + 1) & mask) {
+			if ( table[i].hash == h && table[i].name.equals(key) ) {
+				table[i].value = value;
+				return table[i].value;
+			}
+		}
+		table[i].name = key;
+		table[i].hash = h;
+		table[i].used = true;
+		table[i].value = value;
+		++count;
+		return table[i].value;
+	}
+
+	irr::u32
+	size() const {
+		return count;
+	}
+
+	void
+	clear() {
+		const irr::u32  capacity = table.size();
+		table.clear();
+		allocate(capacity);
+		count = 0;
+	}
+
+	//! Slot access for iterating. Check Entry::used before reading an entry.
+	irr::u32
+	capacity() const {
+		return table.size();
+	}
+
+	Entry&
+	slot( irr::u32  index ) {
+		return table[index];
+	}
+
+private:
+	// Irrlicht's array::set_used() does not construct new elements, so entries are pushed explicitly.
+	void
+	allocate( irr::u32  capacity ) {
+		table.reallocate(capacity);
+		irr::u32  i = 0;
+		for (; i < capacity; ++i)
+			table.push_back( Entry() );
+	}
+
+	void
+	grow() {
+		irr::core::array<Entry>  old;
+		old.swap(table);
+		allocate( old.size() * 2 );
+		count = 0;
+
+		const irr::u32  mask = table.size() - 1;
+		irr::u32  o = 0;
+		irr::u32  i;
+		for (; o < old.size(); ++o) {
+			if ( ! old[o].used )
+				continue;
+			i = old[o].hash & mask;
+			while ( table[i].used )
+				i = (i + 1) & mask;
+			table[i] = old[o];
+			++count;
+		}
+	}
+};
+
+}
+
+#endif
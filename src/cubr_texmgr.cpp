@@ -0,0 +1,197 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_texmgr.h"
+
+namespace cubr {
+
+using irr::u32;
+
+TextureManager::TextureManager( video_driver_t*  driver, size_t  b )
+	: videoDriver(driver)
+	, names()
+	, entries()
+	, clock(0)
+	, bytes(0)
+	, budget(b)
+	, hits(0)
+	, misses(0)
+	, evictions(0)
+{
+	if ( videoDriver )
+		videoDriver->grab();
+}
+
+TextureManager::~TextureManager() {
+	// The textures are left in the video driver
+	dropAll();
+	if ( videoDriver )
+		videoDriver->drop();
+}
+
+texture_t*
+TextureManager::find( const util::String&  name ) {
+	const u32*  index = names.find( name.c_str() );
+	if ( index && entries[*index].texture ) {
+		++hits;
+		entries[*index].lastUse = ++clock;
+		return entries[*index].texture;
+	}
+	++misses;
+	return 0;
+}
+
+void
+TextureManager::add( const util::String&  name, texture_t*  texture ) {
+	const u32*  index = names.find( name.c_str() );
+	Entry*  entry;
+
+	if ( index ) {
+		entry = &(entries[*index]);
+		if ( entry->texture == texture ) {
+			entry->lastUse = ++clock;
+			return;
+		}
+		if ( entry->texture ) {
+			videoDriver->removeTexture( entry->texture );
+			release(*entry);
+		}
+	} else {
+		Entry  e = { 0, 0, 0, 0 };
+		names.insert( name.c_str(), entries.size() );
+		entries.push_back(e);
+		entry = &(entries.getLast());
+	}
+
+	texture->grab();
+	entry->texture = texture;
+	entry->bytes = getTextureBytes(*texture);
+	entry->lastUse = ++clock;
+	// The video driver holds the textures in it until they are removed
+	entry->ownReferences = videoDriver->findTexture( texture->getName().getPath() ) == texture ? 2 : 1;
+	bytes += entry->bytes;
+
+	if ( budget > 0 && bytes > budget )
+		trim(budget, texture);
+}
+
+void
+TextureManager::remove( texture_t*  texture ) {
+	u32  i = 0;
+	for (; i < entries.size(); ++i) {
+		if ( entries[i].texture == texture ) {
+			release(entries[i]);
+			break;
+		}
+	}
+	videoDriver->removeTexture(texture);
+}
+
+u32
+TextureManager::trim( size_t  b, texture_t*  keep ) {
+	irr::core::array<Candidate>  candidates;
+	Candidate  c;
+	u32  removed = 0;
+	u32  i = 0;
+
+	if ( bytes <= b )
+		return 0;
+
+	for (; i < entries.size(); ++i) {
+		if ( entries[i].texture && entries[i].texture != keep && isUnused(entries[i]) ) {
+			c.lastUse = entries[i].lastUse;
+			c.index = i;
+			candidates.push_back(c);
+		}
+	}
+	candidates.sort();
+
+	for (i = 0; i < candidates.size() && bytes > b; ++i) {
+		Entry&  entry = entries[candidates[i].index];
+		videoDriver->removeTexture( entry.texture );
+		release(entry);
+		++removed;
+	}
+	evictions += removed;
+	return removed;
+}
+
+u32
+TextureManager::trim() {
+	return budget > 0 ? trim(budget) : 0;
+}
+
+void
+TextureManager::setVideoDriver( video_driver_t*  driver ) {
+	if ( driver == videoDriver )
+		return;
+	dropAll();
+	names.clear();
+	entries.clear();
+	bytes = 0;
+	if ( driver )
+		driver->grab();
+	if ( videoDriver )
+		videoDriver->drop();
+	videoDriver = driver;
+}
+
+void
+TextureManager::setBudget( size_t  b ) {
+	budget = b;
+	trim();
+}
+
+size_t
+TextureManager::getBudget() const {
+	return budget;
+}
+
+void
+TextureManager::getStats( Stats&  stats ) const {
+	u32  i = 0;
+	stats.textures = 0;
+	stats.used = 0;
+	stats.bytes = bytes;
+	stats.budget = budget;
+	stats.hits = hits;
+	stats.misses = misses;
+	stats.evictions = evictions;
+	for (; i < entries.size(); ++i) {
+		if ( ! entries[i].texture )
+			continue;
+		++stats.textures;
+		if ( ! isUnused(entries[i]) )
+			++stats.used;
+	}
+}
+
+size_t
+TextureManager::getTextureBytes( texture_t&  texture ) {
+	const size_t  top = (size_t)texture.getPitch() * texture.getSize().Height;
+	// The mipmap chain adds a third
+	return texture.hasMipMaps() ? top + top / 3 : top;
+}
+
+bool
+TextureManager::isUnused( const Entry&  entry ) {
+	return entry.texture->getReferenceCount() <= entry.ownReferences;
+}
+
+void
+TextureManager::release( Entry&  entry ) {
+	bytes -= entry.bytes;
+	entry.texture->drop();
+	entry.texture = 0;
+	entry.bytes = 0;
+}
+
+void
+TextureManager::dropAll() {
+	u32  i = 0;
+	for (; i < entries.size(); ++i) {
+		if ( entries[i].texture )
+			entries[i].texture->drop();
+	}
+}
+
+}
@@ -0,0 +1,131 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_TEXTURE_MANAGER_H_
+#define _CUBR_TEXTURE_MANAGER_H_
+
+#include <irrArray.h> // from Irrlicht
+#include <IReferenceCounted.h>
+#include <Strings.h> // from Copper
+#include "cubr_defs.h"
+#include "cubr_strmap.h"
+
+namespace cubr {
+
+//! Texture Manager
+/*
+	Caches the textures loaded by get_texture() and made by image_to_texture() by their Copper name,
+	so repeated lookups neither convert the name to an Irrlicht path nor search the driver.
+	The manager holds a reference to each texture, and the video driver holds one if the texture is
+	in it. Each entry counts these references when the texture is added. Any other reference belongs
+	to a cubrtex or a GUI element, so a texture with no more than the counted ones is unused.
+	The manager also holds a reference to the video driver, so that its textures can still be dropped
+	and removed when it is destroyed after the Irrlicht device.
+	When the textures take more memory than the budget, unused textures are removed from the manager
+	and the video driver, least recently used first. Textures in use are never removed.
+	Names stay in the table after their texture is removed (StringMap cannot remove entries), so
+	getting a removed texture again reuses its entry.
+	The manager is reference-counted so that atlases, which add their texture to it, can outlive the bridge.
+*/
+class TextureManager : public irr::IReferenceCounted {
+public:
+	struct Stats {
+		irr::u32  textures; // Textures cached
+		irr::u32  used; // Cached textures referred to by a cubrtex or GUI element
+		size_t  bytes; // Memory of the cached textures
+		size_t  budget;
+		irr::u32  hits;
+		irr::u32  misses;
+		irr::u32  evictions;
+	};
+
+private:
+	struct Entry {
+		texture_t*  texture;
+		size_t  bytes;
+		irr::u32  lastUse;
+		irr::s32  ownReferences; // Held by the manager and the video driver
+	};
+
+	// Sorts unused entries for trim()
+	struct Candidate {
+		irr::u32  lastUse;
+		irr::u32  index;
+
+		bool
+		operator< ( const Candidate&  other ) const {
+			return lastUse < other.lastUse;
+		}
+	};
+
+	video_driver_t*  videoDriver;
+	StringMap<irr::u32>  names; // Index into entries
+	irr::core::array<Entry>  entries;
+	irr::u32  clock;
+	size_t  bytes;
+	size_t  budget;
+	irr::u32  hits;
+	irr::u32  misses;
+	irr::u32  evictions;
+
+public:
+	//! A budget of zero means no limit.
+	TextureManager( video_driver_t*, size_t  budget = 0 );
+
+	~TextureManager();
+
+	//! Returns the texture stored under the name or null if there is none.
+	texture_t*
+	find( const util::String&  name );
+
+	//! Stores the texture under the name and removes other unused textures if over budget.
+	// A different texture already stored under the name is removed from the video driver.
+	// The texture itself is never removed here, since the caller has yet to use it.
+	void
+	add( const util::String&  name, texture_t* );
+
+	//! Removes the texture from the manager and the video driver.
+	void
+	remove( texture_t* );
+
+	//! Removes unused textures, least recently used first, until the memory is within the given budget.
+	// The kept texture, if any, is not removed even if unused.
+	// Returns the number of textures removed.
+	irr::u32
+	trim( size_t  budget, texture_t*  keep = 0 );
+
+	//! Same as trim() with the budget of the manager.
+	irr::u32
+	trim();
+
+	//! Forgets the cached textures if the driver is a different one. They are left in the old driver.
+	void
+	setVideoDriver( video_driver_t* );
+
+	void
+	setBudget( size_t );
+
+	size_t
+	getBudget() const;
+
+	void
+	getStats( Stats& ) const;
+
+	//! Estimated memory used by the texture, including mipmaps.
+	static size_t
+	getTextureBytes( texture_t& );
+
+private:
+	//! True if only the manager and the video driver refer to the texture.
+	static bool
+	isUnused( const Entry& );
+
+	void
+	release( Entry& );
+
+	void
+	dropAll();
+};
+
+}
+
+#endif
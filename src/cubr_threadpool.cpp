@@ -0,0 +1,187 @@
+// (C) 2026 Nicolaus Anderson
+
+#include "cubr_threadpool.h"
+
+namespace cubr {
+
+//----- Batch
+
+ThreadPool::Batch::Batch( irr::u32  parts )
+	: remaining(parts)
+	, doneLock()
+	, doneSignal()
+	, done(parts == 0)
+	, partCount(parts)
+{}
+
+ThreadPool::Batch::~Batch()
+{}
+
+irr::u32
+ThreadPool::Batch::getPartCount() const {
+	return partCount;
+}
+
+bool
+ThreadPool::Batch::isDone() {
+	std::lock_guard<std::mutex>  guard(doneLock);
+	return done;
+}
+
+void
+ThreadPool::Batch::wait() {
+	std::unique_lock<std::mutex>  guard(doneLock);
+	while ( ! done )
+		doneSignal.wait(guard);
+}
+
+void
+ThreadPool::Batch::partDone() {
+	if ( remaining.fetch_sub(1) != 1 )
+		return;
+
+	// Signalled while locked so that a waiter cannot destroy the batch before the signal is sent
+	std::lock_guard<std::mutex>  guard(doneLock);
+	done = true;
+	doneSignal.notify_all();
+}
+
+//----- ThreadPool
+
+ThreadPool::ThreadPool( irr::u32  threadCount )
+	: workers(0)
+	, threads(0)
+	, workerCount(threadCount)
+	, nextWorker(0)
+	, sleepLock()
+	, wakeSignal()
+	, pending(0)
+	, stopping(false)
+{
+	if ( workerCount == 0 )
+		workerCount = std::thread::hardware_concurrency();
+	if ( workerCount == 0 )
+		workerCount = 1;
+
+	workers = new Worker[workerCount];
+	threads = new std::thread[workerCount];
+	irr::u32  i = 0;
+	for (; i < workerCount; ++i)
+		threads[i] = std::thread( &ThreadPool::work, this, i );
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex>  guard(sleepLock);
+		stopping = true;
+	}
+	wakeSignal.notify_all();
+
+	irr::u32  i = 0;
+	for (; i < workerCount; ++i)
+		threads[i].join();
+
+	delete[] threads;
+	delete[] workers;
+}
+
+irr::u32
+ThreadPool::getThreadCount() const {
+	return workerCount;
+}
+
+void
+ThreadPool::submit( Batch*  batch ) {
+	const irr::u32  parts = batch->getPartCount();
+	if ( parts == 0 )
+		return;
+
+	Item  item;
+	item.batch = batch;
+	irr::u32  w;
+	for ( item.part = 0; item.part < parts; ++item.part ) {
+		w = nextWorker;
+		nextWorker = (nextWorker + 1) % workerCount;
+		std::lock_guard<std::mutex>  guard(workers[w].lock);
+		workers[w].queue.push_back(item);
+	}
+	{
+		std::lock_guard<std::mutex>  guard(sleepLock);
+		pending += parts;
+	}
+	wakeSignal.notify_all();
+}
+
+void
+ThreadPool::runUntilDone( Batch*  batch, bool  submitted ) {
+	if ( ! submitted )
+		submit(batch);
+
+	// The calling thread acts as an extra worker that only steals
+	Item  item;
+	while ( ! batch->isDone() ) {
+		if ( takeItem(workerCount, item) ) {
+			runItem(item);
+		} else {
+			batch->wait();
+		}
+	}
+}
+
+void
+ThreadPool::work( irr::u32  index ) {
+	Item  item;
+	while ( true ) {
+		if ( takeItem(index, item) ) {
+			runItem(item);
+			continue;
+		}
+		std::unique_lock<std::mutex>  guard(sleepLock);
+		while ( pending == 0 && ! stopping )
+			wakeSignal.wait(guard);
+		if ( pending == 0 && stopping )
+			return;
+	}
+}
+
+// Takes an item from the back of the worker's own queue or the front of another's.
+// An index of workerCount has no queue of its own.
+bool
+ThreadPool::takeItem( irr::u32  index, Item&  item ) {
+	bool  found = false;
+	irr::u32  i = 0;
+	irr::u32  w;
+
+	if ( index < workerCount ) {
+		std::lock_guard<std::mutex>  guard(workers[index].lock);
+		if ( ! workers[index].queue.empty() ) {
+			item = workers[index].queue.back();
+			workers[index].queue.pop_back();
+			found = true;
+		}
+	}
+	for (; ! found && i < workerCount; ++i) {
+		w = (index + 1 + i) % workerCount;
+		if ( w == index )
+			continue;
+		std::lock_guard<std::mutex>  guard(workers[w].lock);
+		if ( ! workers[w].queue.empty() ) {
+			item = workers[w].queue.front();
+			workers[w].queue.pop_front();
+			found = true;
+		}
+	}
+	if ( found ) {
+		std::lock_guard<std::mutex>  guard(sleepLock);
+		--pending;
+	}
+	return found;
+}
+
+void
+ThreadPool::runItem( const Item&  item ) {
+	item.batch->runPart(item.part);
+	item.batch->partDone();
+}
+
+}
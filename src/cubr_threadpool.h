@@ -0,0 +1,112 @@
+// (C) 2026 Nicolaus Anderson
+
+#ifndef _CUBR_THREADPOOL_H_
+#define _CUBR_THREADPOOL_H_
+
+#include <irrTypes.h> // from Irrlicht
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace cubr {
+
+//! Thread Pool
+/*
+	Runs batches of independent parts on worker threads.
+	Each worker has its own queue. Parts are handed out round-robin, and a worker whose queue is empty
+	takes parts from the front of the other queues (work stealing).
+	Batches must stay alive until they are done. The pool finishes all submitted work before it is destroyed.
+*/
+class ThreadPool {
+public:
+	//! Work split into a number of parts that can run in any order and on any thread
+	class Batch {
+		std::atomic<irr::u32>  remaining;
+		std::mutex  doneLock;
+		std::condition_variable  doneSignal;
+		bool  done;
+
+	public:
+		Batch( irr::u32  partCount );
+
+		virtual ~Batch();
+
+		irr::u32
+		getPartCount() const;
+
+		bool
+		isDone();
+
+		//! Blocks until all parts have run. Does not help run them (see ThreadPool::runUntilDone()).
+		void
+		wait();
+
+		//! Called by the pool after running a part. The batch must not be used after the last part is done.
+		void
+		partDone();
+
+	protected:
+		//! Called from any thread
+		virtual void
+		runPart( irr::u32 ) = 0;
+
+	private:
+		friend class ThreadPool;
+		irr::u32  partCount;
+	};
+
+	//! A thread count of zero uses the number of hardware threads.
+	ThreadPool( irr::u32  threadCount = 0 );
+
+	~ThreadPool();
+
+	irr::u32
+	getThreadCount() const;
+
+	//! Queues the parts of the batch
+	void
+	submit( Batch* );
+
+	//! Queues the parts of the batch if it has not been submitted and runs parts on the calling thread
+	//! until the batch is done.
+	void
+	runUntilDone( Batch*, bool  submitted = false );
+
+private:
+	struct Item {
+		Batch*  batch;
+		irr::u32  part;
+	};
+
+	struct Worker {
+		std::deque<Item>  queue;
+		std::mutex  lock;
+	};
+
+	Worker*  workers;
+	std::thread*  threads;
+	irr::u32  workerCount;
+	irr::u32  nextWorker;
+
+	std::mutex  sleepLock;
+	std::condition_variable  wakeSignal;
+	irr::u32  pending; // Guarded by sleepLock
+	bool  stopping;
+
+	ThreadPool( const ThreadPool& ); // Not copyable
+
+	void
+	work( irr::u32  index );
+
+	bool
+	takeItem( irr::u32  index, Item&  item );
+
+	void
+	runItem( const Item& );
+};
+
+}
+
+#endif
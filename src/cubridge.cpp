@@ -7,9 +7,16 @@
 #include "cubr_attr.h"
 #include "cubr_guiwatcher.h"
 #include "cubr_image.h"
+#include "cubr_imgjob.h"
+#include "cubr_atlas.h"
+#include "cubr_imgload.h"
+#include "cubr_threadpool.h"
+#include "cubr_geom.h"
+#include "cubr_marshal.h"
 #include <IVideoDriver.h>
 #include <IGUIButton.h>
 #include <IGUIEnvironment.h>
+#include <cstring>
 
 //! Often Checked Attributes Definition
 /*
@@ -54,6 +61,16 @@ CuBridge::CuBridge(
 	: engine(eng)
 	, guiEnvironment(gui_environment)
 	, rootElement( gui_root_element )
+	, attributeSetters()
+	, hotAttributes()
+	, useNativeGeometry(flags.nativeGeometry)
+	, imageThreadCount(flags.imageThreads)
+	, imagePool(0)
+	, textureManager( new TextureManager(gui_environment->getVideoDriver(), flags.textureBudget) )
+	, pendingLoads()
+	, eventQueue(REAL_NULL)
+	, eventRouter(eng)
+	, eventRouterInstalled(false)
 #ifdef INCLUDE_CUBR_JSON
 	, jsonHub(gui_environment->getFileSystem())
 #endif
@@ -68,6 +85,7 @@ CuBridge::CuBridge(
 			gsx("gui_create"),
 			gsxe("gui_new_empty"),
 			gsxw("gui_watcher"),
+			gsxo("gui_on"),
 				// info
 			s1p("gui_parent"),
 			s1c1("gui_child_with_id"),
@@ -78,6 +96,7 @@ CuBridge::CuBridge(
 
 			s2("gui_attrs"),
 			s3("gui_value"),
+			s3a("gui_set"),
 			//s3b("gui_specifics"),
 			s4("gui_to_front"),
 			s5("gui_enabled"),
@@ -92,41 +111,135 @@ CuBridge::CuBridge(
 			is2("image_size"),
 			is3("get_pixel"),
 			is4("set_pixel"),
-			ts0("get_texture")
+			is5("image_get_row"),
+			is6("image_set_row"),
+			is7("image_fill_rect"),
+			is8("image_write_rect"),
+			is9("image_convert"),
+			is10("image_fill"),
+			is11("image_blit"),
+			is12("image_blend"),
+			is13("image_premultiply"),
+			is14("image_run"),
+			is15("image_job"),
+			js0("job_wait"),
+			js1("job_done"),
+			js2("job_result"),
+			ps0("pixels_create"),
+			ps1("pixels_get"),
+			ps2("pixels_set"),
+			ps3("pixels_size"),
+			is16("image_view"),
+			ts0("get_texture"),
+			ts1("texture_update"),
+			ts2("texture_lock"),
+			ts3("texture_unlock"),
+			ts4("texture_remove_from_driver"),
+			ts5("texture_trim"),
+			ts6("texture_budget"),
+			ts7("texture_stats"),
+			ls0("image_load_async"),
+			ls1("texture_preload"),
+			ls2("load_done"),
+			ls3("load_wait"),
+			ls4("load_result"),
+			as0("atlas_create"),
+			as1("atlas_add"),
+			as2("atlas_commit"),
+			as3("sprite_rect"),
+			as4("sprite_texture"),
+				// geometry
+			gs0("rect_create"),
+			gs1("vec2_create"),
+			gs2("dim2_create"),
+			gs3("geom_get"),
+			gs4("geom_set"),
+			fs0("floats_create"),
+			fs1("floats_get"),
+			fs2("floats_set"),
+			fs3("floats_size")
 			;
 
 	Cu::addForeignMethodInstance<CuBridge>(engine, s0, this, &CuBridge::gui_getRoot);
 	Cu::addForeignMethodInstance<CuBridge>(engine, gsx, this, &CuBridge::gui_create);
 	Cu::addForeignMethodInstance<CuBridge>(engine, gsxe, this, &CuBridge::gui_new_empty);
 	Cu::addForeignMethodInstance<CuBridge>(engine, gsxw, this, &CuBridge::gui_watcher);
+	bindFFI(engine, gsxo, this, &CuBridge::gui_on);
 
-	Cu::addForeignMethodInstance<CuBridge>(engine, s1p, this, &CuBridge::gui_parent);
-	Cu::addForeignMethodInstance<CuBridge>(engine, s1c1, this, &CuBridge::gui_child_with_id);
+	bindFFI(engine, s1p, this, &CuBridge::gui_parent);
+	bindFFI(engine, s1c1, this, &CuBridge::gui_child_with_id);
 	//Cu::addForeignMethodInstance<CuBridge>(engine, s1c2, this, &CuBridge::gui_child_at_index);
-	Cu::addForeignMethodInstance<CuBridge>(engine, s1c3, this, &CuBridge::gui_add_child);
-	Cu::addForeignMethodInstance<CuBridge>(engine, s1c4, this, &CuBridge::gui_remove_child);
+	bindFFI(engine, s1c3, this, &CuBridge::gui_add_child);
+	bindFFI(engine, s1c4, this, &CuBridge::gui_remove_child);
 	Cu::addForeignMethodInstance<CuBridge>(engine, s1c5, this, &CuBridge::gui_remove_children);
 
 	Cu::addForeignMethodInstance<CuBridge>(engine, s2, this, &CuBridge::gui_allAttributes);
 	Cu::addForeignMethodInstance<CuBridge>(engine, s3, this, &CuBridge::gui_value);
+	bindFFI(engine, s3a, this, &CuBridge::gui_set);
 	//Cu::addForeignMethodInstance<CuBridge>(engine, s3b, this, &CuBridge::gui_specifics);
-	Cu::addForeignMethodInstance<CuBridge>(engine, s4, this, &CuBridge::gui_to_front);
-	Cu::addForeignMethodInstance<CuBridge>(engine, s5, this, &CuBridge::gui_enabled);
-	Cu::addForeignMethodInstance<CuBridge>(engine, s6, this, &CuBridge::gui_visible);
-	Cu::addForeignMethodInstance<CuBridge>(engine, s7, this, &CuBridge::gui_position);
-	Cu::addForeignMethodInstance<CuBridge>(engine, s8, this, &CuBridge::gui_id);
-	Cu::addForeignMethodInstance<CuBridge>(engine, s9, this, &CuBridge::gui_text);
+	bindFFI(engine, s4, this, &CuBridge::gui_to_front);
+	bindFFI(engine, s5, this, &CuBridge::gui_enabled);
+	bindFFI(engine, s6, this, &CuBridge::gui_visible);
+	bindFFI(engine, s7, this, &CuBridge::gui_position);
+	bindFFI(engine, s8, this, &CuBridge::gui_id);
+	bindFFI(engine, s9, this, &CuBridge::gui_text);
 	Cu::addForeignMethodInstance<CuBridge>(engine, s10, this, &CuBridge::gui_expand);
 
 	Cu::addForeignMethodInstance<CuBridge>(engine, is0, this, &CuBridge::image_create);
-	Cu::addForeignMethodInstance<CuBridge>(engine, is1, this, &CuBridge::image_to_texture);
-	Cu::addForeignMethodInstance<CuBridge>(engine, ts0, this, &CuBridge::texture_access);
-
-	Cu::addForeignFuncInstance(engine, is2, &GetImageDimensions);
+	bindFFI(engine, is1, this, &CuBridge::image_to_texture);
+	bindFFI(engine, is9, this, &CuBridge::image_convert);
+	bindFFI(engine, ts0, this, &CuBridge::texture_access);
+
+	bindFFI(engine, is2, &GetImageDimensions);
+	bindFFI(engine, is5, &GetImageRow);
+	bindFFI(engine, is16, &CreateImageView);
+	bindFFI(engine, ts1, &UpdateTexture);
+	bindFFI(engine, ts2, this, &CuBridge::texture_lock);
+	bindFFI(engine, ts3, this, &CuBridge::texture_unlock);
+	bindFFI(engine, ts4, this, &CuBridge::texture_remove_from_driver);
+	bindFFI(engine, ts5, this, &CuBridge::texture_trim);
+	bindFFI(engine, ts6, this, &CuBridge::texture_budget);
+	bindFFI(engine, ts7, this, &CuBridge::texture_stats);
+	bindFFI(engine, ls0, this, &CuBridge::image_load_async);
+	Cu::addForeignMethodInstance<CuBridge>(engine, ls1, this, &CuBridge::texture_preload);
+	bindFFI(engine, ls2, this, &CuBridge::load_done);
+	bindFFI(engine, ls3, this, &CuBridge::load_wait);
+	bindFFI(engine, ls4, &GetImageLoadResult);
+	bindFFI(engine, as0, this, &CuBridge::atlas_create);
+	bindFFI(engine, as1, this, &CuBridge::atlas_add);
+	bindFFI(engine, as2, &CommitAtlas);
+	bindFFI(engine, as3, &GetSpriteRect);
+	bindFFI(engine, as4, &GetSpriteTexture);
+	bindFFI(engine, ps0, &CreatePixelBuffer);
+	bindFFI(engine, ps1, &GetPixelBufferValue);
+	Cu::addForeignFuncInstance(engine, ps2, &SetPixelBufferValue);
+	bindFFI(engine, ps3, &GetPixelBufferSize);
+
+	Cu::addForeignFuncInstance(engine, gs0, &CreateRect);
+	Cu::addForeignFuncInstance(engine, gs1, &CreateVector2);
+	Cu::addForeignFuncInstance(engine, gs2, &CreateDimension2);
+	bindFFI(engine, gs3, &GetGeometryMember);
+	bindFFI(engine, gs4, &SetGeometryMember);
+	Cu::addForeignFuncInstance(engine, fs0, &CreateFloatArray);
+	bindFFI(engine, fs1, &GetFloatArrayValue);
+	bindFFI(engine, fs2, &SetFloatArrayValue);
+	bindFFI(engine, fs3, &GetFloatArraySize);
 
 	if ( flags.enableImageModifying ) {
-		Cu::addForeignFuncInstance(engine, is3, &GetImagePixel);
-		Cu::addForeignFuncInstance(engine, is4, &SetImagePixel);
+		bindFFI(engine, is3, &GetImagePixel);
+		bindFFI(engine, is4, &SetImagePixel);
+		bindFFI(engine, is6, &SetImageRow);
+		bindFFI(engine, is7, &FillImageRect);
+		bindFFI(engine, is8, &WriteImageRect);
+		bindFFI(engine, is10, &FillImage);
+		bindFFI(engine, is11, &BlitImage);
+		bindFFI(engine, is12, &BlendImage);
+		bindFFI(engine, is13, &PremultiplyImage);
+		Cu::addForeignMethodInstance<CuBridge>(engine, is14, this, &CuBridge::image_run);
+		Cu::addForeignMethodInstance<CuBridge>(engine, is15, this, &CuBridge::image_job);
+		bindFFI(engine, js0, this, &CuBridge::job_wait);
+		bindFFI(engine, js1, &IsImageJobDone);
+		bindFFI(engine, js2, &GetImageJobResult);
 	}
 
 #ifdef INCLUDE_CUBR_JSON
@@ -140,7 +253,16 @@ CuBridge::CuBridge(
 }
 
 CuBridge::~CuBridge() {
-
+	// The GUI environment is held while the router is installed, so it is still here to be given back its receiver
+	uninstallEventRouter();
+	// Loads wait for their files to decode
+	irr::u32  i = 0;
+	for (; i < pendingLoads.size(); ++i)
+		pendingLoads[i]->deref();
+	// Finishes any jobs still queued
+	delete imagePool;
+	// Atlases may still hold the manager
+	textureManager->drop();
 }
 
 Cu::Engine&
@@ -148,9 +270,119 @@ CuBridge::getCuEngine() {
 	return engine;
 }
 
+AttributeSetterTable&
+CuBridge::getAttributeSetters() {
+	return attributeSetters;
+}
+
+HotAttributeTable&
+CuBridge::getHotAttributes() {
+	return hotAttributes;
+}
+
+ThreadPool&
+CuBridge::getImagePool() {
+	if ( ! imagePool )
+		imagePool = new ThreadPool(imageThreadCount);
+	return *imagePool;
+}
+
+TextureManager&
+CuBridge::getTextureManager() {
+	return *textureManager;
+}
+
+irr::u32
+CuBridge::pumpLoads( irr::u32  maxUploads ) {
+	irr::u32  uploads = 0;
+	irr::u32  i = 0;
+	ImageLoad*  load;
+
+	while ( i < pendingLoads.size() ) {
+		load = pendingLoads[i];
+		if ( ! load->isFinished() ) {
+			if ( ! load->isRead() || ( maxUploads > 0 && uploads >= maxUploads ) ) {
+				++i;
+				continue;
+			}
+			uploads += load->finish( *this, maxUploads > 0 ? maxUploads - uploads : 0 );
+			if ( ! load->isFinished() ) {
+				++i;
+				continue;
+			}
+		}
+		// Removed first since the callback may start other loads
+		pendingLoads.erase(i);
+		if ( load->getCallback() ) {
+			util::List<Cu::Object*>  args;
+			args.push_back(load);
+			engine.runFunctionObject( load->getCallback(), &args );
+		}
+		load->deref();
+	}
+	return pendingLoads.size();
+}
+
+ImageLoad*
+CuBridge::startImageLoad(
+	const irr::core::array<util::String>&  names,
+	bool  makeTextures,
+	Cu::FunctionObject*  callback
+) {
+	irr::core::array<bool>  decode;
+	irr::u32  i = 0;
+	decode.reallocate(names.size());
+	for (; i < names.size(); ++i)
+		decode.push_back( canDecodeAsync(names[i]) );
+	ImageLoad*  load = new ImageLoad( guiEnvironment->getVideoDriver(), guiEnvironment->getFileSystem(), names, decode, makeTextures );
+	load->setCallback(callback);
+	getImagePool().submit( load->getBatch() );
+	// The pending list keeps its own reference until the callback has run
+	load->ref();
+	pendingLoads.push_back(load);
+	return load;
+}
+
+void
+CuBridge::setEventQueue( GUIEventQueue*  queue ) {
+	eventQueue = queue;
+	eventRouter.setEventQueue(queue);
+}
+
+EventRouter&
+CuBridge::getEventRouter() {
+	return eventRouter;
+}
+
+void
+CuBridge::installEventRouter( irr::IEventReceiver*  next ) {
+	eventRouter.setNext(next);
+	guiEnvironment->setUserEventReceiver(&eventRouter);
+	if ( ! eventRouterInstalled )
+		guiEnvironment->grab();
+	eventRouterInstalled = true;
+}
+
+void
+CuBridge::uninstallEventRouter() {
+	if ( ! eventRouterInstalled )
+		return;
+	guiEnvironment->setUserEventReceiver( eventRouter.getNext() );
+	guiEnvironment->drop();
+	eventRouterInstalled = false;
+}
+
 void
 CuBridge::setGUIEnvironment( gui_environment_t*  env, gui_element_t*  root ) {
+	if ( eventRouterInstalled ) {
+		// The router moves to the new environment
+		guiEnvironment->setUserEventReceiver( eventRouter.getNext() );
+		env->setUserEventReceiver(&eventRouter);
+		env->grab();
+		guiEnvironment->drop();
+	}
 	guiEnvironment = env;
+	textureManager->setVideoDriver( guiEnvironment->getVideoDriver() );
 	if ( root ) {
 		rootElement = root;
 	} else {
@@ -207,19 +439,10 @@ CuBridge::gui_new_empty( Cu::FFIServices& ffi ) {
 ForeignFunc::Result
 CuBridge::gui_watcher( Cu::FFIServices& ffi ) {
 
-	GUIWatcherObject*  elem =
-		new GUIWatcherObject(
-			&engine,
-			guiEnvironment,
-			rootElement
-		);
-
-	elem->expandToParentBounds();
-	ffi.setNewResult(elem);
-
 	GUIElement*  otherElem = nullptr;
 	util::String  callbackEvent;
 	Cu::FunctionObject*  callback = REAL_NULL;
+	irr::gui::EGUI_EVENT_TYPE  eventType = irr::gui::EGET_COUNT;
 
 	switch( ffi.getArgCount() )
 	{
@@ -265,6 +488,26 @@ CuBridge::gui_watcher( Cu::FFIServices& ffi ) {
 	default: break;
 	}
 
+	// Checked before the watcher is made so that no watcher is left in the GUI
+	if ( notNull(callback) ) {
+		eventType = getGUIEventTypeFromString( callbackEvent );
+		if ( eventType == irr::gui::EGET_COUNT ) {
+			ffi.printCustomWarningCode( CuBridgeMessageCode::GUIEventUnknownType );
+			return ForeignFunc::NONFATAL;
+		}
+	}
+
+	GUIWatcherObject*  elem =
+		new GUIWatcherObject(
+			&engine,
+			guiEnvironment,
+			rootElement
+		);
+
+	elem->expandToParentBounds();
+	elem->setEventQueue(eventQueue);
+	ffi.setNewResult(elem);
+
 	irr::core::recti  elemRect;
 	irr::gui::IGUIElement* otherElemElem;
 	irr::gui::IGUIElement* elemElem;
@@ -279,12 +522,24 @@ CuBridge::gui_watcher( Cu::FFIServices& ffi ) {
 		elemElem->addChild(otherElemElem);
 		otherElem->expandToParentBounds();
 	}
-	if ( notNull(callback) ) {
-		elem->setCallback(
-			getGUIEventTypeFromString( callbackEvent ),
-			callback
-		);
+	if ( notNull(callback) )
+		elem->setCallback( eventType, callback );
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::gui_on(
+	Cu::FFIServices&  ffi,
+	GUIElement&  element,
+	Cu::StringObject&  eventName,
+	Optional<Cu::FunctionObject&>  callback
+) {
+	const irr::gui::EGUI_EVENT_TYPE  eventType = getGUIEventTypeFromString( eventName.getString() );
+	if ( eventType == irr::gui::EGET_COUNT ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::GUIEventUnknownType );
+		return ForeignFunc::NONFATAL;
 	}
+	eventRouter.setCallback( element.getElement(), eventType, callback.isSet() ? &(callback.get()) : REAL_NULL );
 	return ForeignFunc::FINISHED;
 }
 
@@ -312,18 +567,49 @@ CuBridge::gui_instantiate( Cu::FFIServices& ffi ) {
 ForeignFunc::Result
 CuBridge::gui_allAttributes( Cu::FFIServices& ffi ) {
 	irr::io::SAttributeReadWriteOptions  options;
+	if ( ffi.getArgCount() >= 2 && Cu::isStringObject(ffi.arg(1)) )
+		return gui_attributeProjection(ffi, options);
 	return gui_attributeSelector(ffi, options);
 }
 
 ForeignFunc::Result
 CuBridge::gui_value( Cu::FFIServices& ffi ) {
+	// Setting values does not need to pass through deserializeAttributes()
+	if ( ffi.getArgCount() == 2 ) {
+		if ( !ffi.demandArgType(0, GUIElement::getTypeAsCuType())
+			|| !ffi.demandArgType(1, Cu::ObjectType::Function)
+		) {
+			return ForeignFunc::NONFATAL;
+		}
+		return gui_set(ffi, (GUIElement&)ffi.arg(0), (Cu::FunctionObject&)ffi.arg(1));
+	}
+
 	irr::io::SAttributeReadWriteOptions  options;
 #ifdef USE_IRR_OFTEN_CHECKED_ATTRS // See note at top of file
 	options.Flags = irr::io::EARWF_OFTEN_CHECKED_ATTRS;
+#else
+	if ( ffi.getArgCount() == 1 && ffi.arg(0).getType() == GUIElement::getTypeAsCuType() ) {
+		gui_element_t*  e = ((GUIElement&)ffi.arg(0)).getElement();
+		HotAttributeGetter  getter = hotAttributes.find( e->getType() );
+		if ( getter ) {
+			Cu::FunctionObject*  attrsContainer = new Cu::FunctionObject();
+			AttributeSource  attrSource( guiEnvironment->getVideoDriver(), *attrsContainer, useNativeGeometry );
+			getter(e, attrSource);
+			ffi.setNewResult(attrsContainer);
+			return ForeignFunc::FINISHED;
+		}
+	}
 #endif
 	return gui_attributeSelector(ffi, options);
 }
 
+ForeignFunc::Result
+CuBridge::gui_set( Cu::FFIServices& ffi, GUIElement& element, Cu::FunctionObject& attributes ) {
+	AttributeSource  attrSource( guiEnvironment->getVideoDriver(), attributes );
+	element.setAttributes(attrSource, attributeSetters);
+	return ForeignFunc::FINISHED;
+}
+
 /*ForeignFunc::Result
 CuBridge::gui_specifics( Cu::FFIServices& ffi ) {
 	irr::io::SAttributeReadWriteOptions  options;
@@ -332,17 +618,12 @@ CuBridge::gui_specifics( Cu::FFIServices& ffi ) {
 }*/
 
 ForeignFunc::Result
-CuBridge::gui_parent( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCountRange(1,2)
-		|| !ffi.demandAllArgsType(GUIElement::getTypeAsCuType())
-	) {
-		return ForeignFunc::NONFATAL;
-	}
-	gui_element_t*  child = ((GUIElement&)ffi.arg(0)).getElement();
+CuBridge::gui_parent( Cu::FFIServices& ffi, GUIElement& childElement, Optional<GUIElement&> parent ) {
+	gui_element_t*  child = childElement.getElement();
 
-	if ( ffi.getArgCount() == 2 ) {
+	if ( parent.isSet() ) {
 		// The parent is being set
-		((GUIElement&)ffi.arg(1)).addChild(child);
+		parent.get().addChild(child);
 	} else {
 		// The parent is being requested
 		ffi.setNewResult( new GUIElement(child->getParent(), guiEnvironment) );
@@ -351,16 +632,7 @@ CuBridge::gui_parent( Cu::FFIServices& ffi ) {
 }
 
 ForeignFunc::Result
-CuBridge::gui_child_with_id( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCount(2)
-		|| !ffi.demandArgType(0, GUIElement::getTypeAsCuType())
-		|| !ffi.demandArgType(1, Cu::ObjectType::Numeric)
-	) {
-		return ForeignFunc::NONFATAL;
-	}
-	
-	GUIElement&  parent = (GUIElement&)ffi.arg(0);
-	Cu::NumericObject&  id = (Cu::NumericObject&)ffi.arg(1);
+CuBridge::gui_child_with_id( Cu::FFIServices& ffi, GUIElement& parent, Cu::NumericObject& id ) {
 	gui_element_t*  child = parent.getChildWithId( id.getIntegerValue(), false );
 	// Irrlicht returns a zero if the child is not found
 	if ( child ) {
@@ -372,12 +644,8 @@ CuBridge::gui_child_with_id( Cu::FFIServices& ffi ) {
 }
 
 ForeignFunc::Result
-CuBridge::gui_add_child( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCount(2) || !ffi.demandAllArgsType( GUIElement::getTypeAsCuType() ) ) {
-		return ForeignFunc::NONFATAL;
-	}
-	GUIElement&  parent = (GUIElement&)ffi.arg(0);
-	gui_element_t*  child = ((GUIElement&)ffi.arg(1)).getElement();
+CuBridge::gui_add_child( Cu::FFIServices& ffi, GUIElement& parent, GUIElement& childElement ) {
+	gui_element_t*  child = childElement.getElement();
 
 	if ( child ) {
 		parent.addChild(child);
@@ -388,15 +656,13 @@ CuBridge::gui_add_child( Cu::FFIServices& ffi ) {
 }
 
 ForeignFunc::Result
-CuBridge::gui_remove_child( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCount(2) || !ffi.demandAllArgsType( GUIElement::getTypeAsCuType() ) ) {
-		return ForeignFunc::NONFATAL;
-	}
-	GUIElement&  parent = (GUIElement&)ffi.arg(0);
-	gui_element_t*  child = ((GUIElement&)ffi.arg(1)).getElement();
+CuBridge::gui_remove_child( Cu::FFIServices& ffi, GUIElement& parent, GUIElement& childElement ) {
+	gui_element_t*  child = childElement.getElement();
 
 	if ( child ) {
 		parent.removeChild(child);
+		// The child is still held by the argument, but its descendants may now only be held by the router
+		eventRouter.prune();
 	} else {
 		ffi.printCustomInfoCode(CuBridgeMessageCode::GUIElementIsEmpty);
 	}
@@ -415,33 +681,20 @@ CuBridge::gui_remove_children( Cu::FFIServices& ffi ) {
 		element = & (GUIElement&)(ffi.arg(argIndex) );
 		element->removeChildren();
 	}
+	eventRouter.prune();
 	return ForeignFunc::FINISHED;
 }
 
 ForeignFunc::Result
-CuBridge::gui_to_front( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCount(1) || !ffi.demandArgType(0, GUIElement::getTypeAsCuType()) ) {
-		return ForeignFunc::NONFATAL;
-	}
-	GUIElement& elem = (GUIElement&)ffi.arg(0);
+CuBridge::gui_to_front( Cu::FFIServices& ffi, GUIElement& elem ) {
 	elem.bringToFrontOnParent();
 	return ForeignFunc::FINISHED;
 }
 
 ForeignFunc::Result
-CuBridge::gui_enabled( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCountRange(1,2)
-		|| !ffi.demandArgType(0, GUIElement::getTypeAsCuType())
-	) {
-		return ForeignFunc::NONFATAL;
-	}
-	GUIElement&  elem = (GUIElement&)ffi.arg(0);
-
-	if ( ffi.getArgCount() == 2 ) {
-		if ( !ffi.demandArgType(1, Cu::ObjectType::Bool) )
-			return ForeignFunc::NONFATAL;
-
-		elem.setEnabled( (Cu::BoolObject&)ffi.arg(1) );
+CuBridge::gui_enabled( Cu::FFIServices& ffi, GUIElement& elem, Optional<Cu::BoolObject&> setting ) {
+	if ( setting.isSet() ) {
+		elem.setEnabled( setting.get() );
 	} else {
 		ffi.setNewResult( new Cu::BoolObject( elem.isEnabled() ) );
 	}
@@ -449,19 +702,9 @@ CuBridge::gui_enabled( Cu::FFIServices& ffi ) {
 }
 
 ForeignFunc::Result
-CuBridge::gui_visible( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCountRange(1,2)
-		|| !ffi.demandArgType(0, GUIElement::getTypeAsCuType())
-	) {
-		return ForeignFunc::NONFATAL;
-	}
-	GUIElement&  elem = (GUIElement&)ffi.arg(0);
-
-	if ( ffi.getArgCount() == 2 ) {
-		if ( !ffi.demandArgType(1, Cu::ObjectType::Bool) )
-			return ForeignFunc::NONFATAL;
-
-		elem.setVisible( (Cu::BoolObject&)ffi.arg(1) );
+CuBridge::gui_visible( Cu::FFIServices& ffi, GUIElement& elem, Optional<Cu::BoolObject&> setting ) {
+	if ( setting.isSet() ) {
+		elem.setVisible( setting.get() );
 	} else {
 		ffi.setNewResult( new Cu::BoolObject( elem.isVisible() ) );
 	}
@@ -469,21 +712,21 @@ CuBridge::gui_visible( Cu::FFIServices& ffi ) {
 }
 
 ForeignFunc::Result
-CuBridge::gui_position( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCountRange(1, 2)
-		|| !ffi.demandArgType(0, GUIElement::getTypeAsCuType())
-	) {
-		return ForeignFunc::NONFATAL;
-	}
-	GUIElement&  elem = (GUIElement&)ffi.arg(0);
+CuBridge::gui_position( Cu::FFIServices& ffi, GUIElement& elem, Optional<Cu::Object&> setting ) {
 	Cu::FunctionObject*  pos_data;
 
-	if ( ffi.getArgCount() == 2 ) {
+	if ( setting.isSet() ) {
+		if ( isRectObject(setting.get()) ) {
+			elem.getElement()->setRelativePosition( ((Rect&)setting.get()).get() );
+			return ForeignFunc::FINISHED;
+		}
 		if ( !ffi.demandArgType(1, Cu::ObjectType::Function) ) {
 			return ForeignFunc::NONFATAL;
 		}
-		pos_data = &((Cu::FunctionObject&)ffi.arg(1));
+		pos_data = &((Cu::FunctionObject&)setting.get());
 		elem.setRelativePosition( *pos_data );
+	} else if ( useNativeGeometry ) {
+		ffi.setNewResult( new Rect( elem.getElement()->getRelativePosition() ) );
 	} else {
 		pos_data = new Cu::FunctionObject();
 		elem.getRelativePosition( *pos_data );
@@ -493,20 +736,9 @@ CuBridge::gui_position( Cu::FFIServices& ffi ) {
 }
 
 ForeignFunc::Result
-CuBridge::gui_id( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCountRange(1,2)
-		|| !ffi.demandArgType(0, GUIElement::getTypeAsCuType())
-	) {
-		ffi.setNewResult( new Cu::IntegerObject( 0 ) );
-		return ForeignFunc::NONFATAL;
-	}
-	GUIElement&  elem = (GUIElement&)ffi.arg(0);
-
-	if ( ffi.getArgCount() == 2 ) {
-		if ( !ffi.demandArgType(1, Cu::ObjectType::Numeric) ) {
-			return ForeignFunc::NONFATAL;
-		}
-		elem.setID( (Cu::NumericObject&)ffi.arg(1) );
+CuBridge::gui_id( Cu::FFIServices& ffi, GUIElement& elem, Optional<Cu::NumericObject&> setting ) {
+	if ( setting.isSet() ) {
+		elem.setID( setting.get() );
 	} else {
 		ffi.setNewResult( new Cu::IntegerObject( elem.getID() ) );
 	}
@@ -514,19 +746,9 @@ CuBridge::gui_id( Cu::FFIServices& ffi ) {
 }
 
 ForeignFunc::Result
-CuBridge::gui_text( Cu::FFIServices& ffi ) {
-	if ( !ffi.demandArgCountRange(1,2)
-		|| !ffi.demandArgType(0, GUIElement::getTypeAsCuType())
-	) {
-		return ForeignFunc::NONFATAL;
-	}
-	GUIElement&  elem = (GUIElement&)ffi.arg(0);
-
-	if ( ffi.getArgCount() == 2 ) {
-		if ( !ffi.demandArgType(1, Cu::ObjectType::String) ) {
-			return ForeignFunc::NONFATAL;
-		}
-		elem.setText( (Cu::StringObject&)ffi.arg(1) );
+CuBridge::gui_text( Cu::FFIServices& ffi, GUIElement& elem, Optional<Cu::StringObject&> setting ) {
+	if ( setting.isSet() ) {
+		elem.setText( setting.get() );
 	} else {
 		ffi.setNewResult( new Cu::StringObject( elem.getText() ) );
 	}
@@ -547,6 +769,9 @@ CuBridge::gui_expand( Cu::FFIServices& ffi ) {
 			ffi.printCustomWarningCode( CuBridgeMessageCode::GUIElementLacksParent );
 		}
 	}
+	if ( useNativeGeometry ) {
+		ffi.setNewResult( new Rect( ((GUIElement&)ffi.arg(i-1)).getElement()->getRelativePosition() ) );
+	}
 	return ForeignFunc::FINISHED;
 }
 
@@ -595,7 +820,7 @@ CuBridge::gui_attributeSelector( Cu::FFIServices&  ffi, irr::io::SAttributeReadW
 	if ( !attrsContainer ) {
 		attrsContainer = new Cu::FunctionObject();
 	}
-	AttributeSource  attrSource( guiEnvironment->getVideoDriver(), *attrsContainer );
+	AttributeSource  attrSource( guiEnvironment->getVideoDriver(), *attrsContainer, useNativeGeometry );
 	if ( foundAttrs ) {
 		element.getElement()->deserializeAttributes(&attrSource, &options);
 	} else {
@@ -605,6 +830,30 @@ CuBridge::gui_attributeSelector( Cu::FFIServices&  ffi, irr::io::SAttributeReadW
 	return ForeignFunc::FINISHED;
 }
 
+ForeignFunc::Result
+CuBridge::gui_attributeProjection( Cu::FFIServices&  ffi, irr::io::SAttributeReadWriteOptions&  options ) {
+	if ( !ffi.demandMinArgCount(2)
+		|| !ffi.demandArgType(0, GUIElement::getTypeAsCuType())
+	) {
+		return ForeignFunc::NONFATAL;
+	}
+	const irr::u32  argCount = ffi.getArgCount();
+	irr::u32  a = 1;
+	for (; a < argCount; ++a) {
+		if ( !ffi.demandArgType(a, Cu::ObjectType::String) )
+			return ForeignFunc::NONFATAL;
+	}
+	GUIElement&  element = (GUIElement&)ffi.arg(0);
+	Cu::FunctionObject*  attrsContainer = new Cu::FunctionObject();
+	AttributeSource  attrSource( guiEnvironment->getVideoDriver(), *attrsContainer, useNativeGeometry );
+	for (a = 1; a < argCount; ++a) {
+		attrSource.project( ((Cu::StringObject&)ffi.arg(a)).getString().c_str() );
+	}
+	element.getElement()->serializeAttributes(&attrSource, &options);
+	ffi.setNewResult(attrsContainer);
+	return ForeignFunc::FINISHED;
+}
+
 irr::video::ECOLOR_FORMAT
 CuBridge::stringToColorFormat( util::String  s ) {
 	if ( s.equals( "A1R5G5B5" ) )
@@ -645,51 +894,438 @@ CuBridge::image_create( Cu::FFIServices&  ffi ) {
 }
 
 ForeignFunc::Result
-CuBridge::image_to_texture( Cu::FFIServices&  ffi ) {
-	if ( !ffi.demandArgType(0, Image::getTypeAsCuType())
-		|| !ffi.demandArgType(1, Cu::ObjectType::String)
+CuBridge::image_convert( Cu::FFIServices&  ffi, Image&  image, Cu::StringObject&  format ) {
+	irr::video::ECOLOR_FORMAT  colorFormat = stringToColorFormat( format.getString() );
+
+	image_t*  img = createImageCopy( image, colorFormat );
+	if ( !img ) {
+		return ForeignFunc::NONFATAL;
+	}
+	ffi.setNewResult( new Image(img, guiEnvironment->getVideoDriver()) );
+	img->drop();
+	return ForeignFunc::FINISHED;
+}
+
+// Creates the private copy that an in-place kernel of a deferred job changes and returns the image to give the job,
+// which the caller must deref. For region views, the parent is copied and the job gets the same region of the copy.
+static Image*
+createJobOutput( Image&  image, Image*&  output ) {
+	output = (Image*)( image.isRegion() ? image.getParent() : &image )->copy();
+	if ( image.isRegion() )
+		return new Image( *output, image.getRegion() );
+	output->ref();
+	return output;
+}
+
+ImageJob*
+CuBridge::createImageJob( Cu::FFIServices&  ffi, bool  deferred, Cu::Object*&  result, Cu::Object*&  input, Image*&  output ) {
+	result = REAL_NULL;
+	input = REAL_NULL;
+	output = REAL_NULL;
+	if ( !ffi.demandArgCountRange(3,5)
+		|| !ffi.demandArgType(0, Cu::ObjectType::String)
 	) {
+		return 0;
+	}
+
+	const util::String&  name = ((Cu::StringObject&)ffi.arg(0)).getString();
+	video_driver_t*  driver = guiEnvironment->getVideoDriver();
+	ImageJob*  job;
+	Image*  source;
+	Image*  target;
+	image_t*  img;
+	irr::u32  colors[2] = { 0, 0 };
+
+	if ( name.equals("fill") || name.equals("gradient") ) {
+		const bool  gradient = name.equals("gradient");
+		if ( gradient ) {
+			if ( !ffi.demandArgCountRange(4,5)
+				|| !getColorArg(ffi, 2, colors[0])
+				|| !getColorArg(ffi, 3, colors[1])
+				|| ( ffi.getArgCount() == 5 && !ffi.demandArgType(4, Cu::ObjectType::Bool) )
+			) {
+				return 0;
+			}
+		} else if ( !ffi.demandArgCount(3) || !getColorArg(ffi, 2, colors[0]) ) {
+			return 0;
+		}
+		target = getPackableImageArg(ffi, true, 1);
+		if ( !target )
+			return 0;
+
+		// The script can still read the image while a deferred job runs, so the job changes a copy
+		if ( deferred && ! target->isView() )
+			target = createJobOutput(*target, output);
+		else
+			target->ref();
+		job = new ImageJob( gradient ? ImageJob::Kernel::Gradient : ImageJob::Kernel::Fill, 0, *target );
+		target->deref();
+		job->colors[0] = colors[0];
+		job->colors[1] = colors[1];
+		if ( ffi.getArgCount() == 5 )
+			job->vertical = ((Cu::BoolObject&)ffi.arg(4)).getValue();
+		if ( ! output )
+			((Image&)ffi.arg(1)).setAllDirty();
+		result = &(ffi.arg(1));
+		result->ref();
+		return job;
+	}
+
+	if ( name.equals("color_matrix") ) {
+		if ( !ffi.demandArgCount(3)
+			|| !ffi.demandArgType(2, FloatArray::getTypeAsCuType())
+		) {
+			return 0;
+		}
+		target = getPackableImageArg(ffi, true, 1);
+		if ( !target )
+			return 0;
+
+		if ( deferred && ! target->isView() )
+			target = createJobOutput(*target, output);
+		else
+			target->ref();
+		FloatArray&  matrix = (FloatArray&)ffi.arg(2);
+		job = new ImageJob( ImageJob::Kernel::ColorMatrix, 0, *target );
+		target->deref();
+		// Values missing from smaller arrays keep the identity
+		memcpy( job->matrix, matrix.data(), matrix.size() * sizeof(irr::f32) );
+		if ( ! output )
+			((Image&)ffi.arg(1)).setAllDirty();
+		result = &(ffi.arg(1));
+		result->ref();
+		return job;
+	}
+
+	if ( name.equals("convert") ) {
+		if ( !ffi.demandArgCount(3)
+			|| !ffi.demandArgType(2, Cu::ObjectType::String)
+		) {
+			return 0;
+		}
+		source = getPackableImageArg(ffi, false, 1);
+		if ( !source )
+			return 0;
+
+		img = driver->createImage(
+			stringToColorFormat( ((Cu::StringObject&)ffi.arg(2)).getString() ),
+			source->getSize()
+		);
+	}
+	else if ( name.equals("resample") ) {
+		if ( !ffi.demandArgCount(4)
+			|| !ffi.demandArgType(2, Cu::ObjectType::Numeric)
+			|| !ffi.demandArgType(3, Cu::ObjectType::Numeric)
+		) {
+			return 0;
+		}
+		source = getPackableImageArg(ffi, false, 1);
+		if ( !source )
+			return 0;
+
+		const Cu::Integer  width = ((Cu::NumericObject&)ffi.arg(2)).getIntegerValue();
+		const Cu::Integer  height = ((Cu::NumericObject&)ffi.arg(3)).getIntegerValue();
+		img = driver->createImage(
+			source->getImage()->getColorFormat(),
+			core::dimension2du( (irr::u32)core::max_(width, (Cu::Integer)1), (irr::u32)core::max_(height, (Cu::Integer)1) )
+		);
+	}
+	else {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::ImageJobUnknownKernel );
+		return 0;
+	}
+
+	target = new Image(img, driver);
+	img->drop();
+	job = new ImageJob(
+		name.equals("convert") ? ImageJob::Kernel::Convert : ImageJob::Kernel::Resample,
+		source, *target
+	);
+	result = target;
+	// The copy shares the source buffer, so the script cannot change it without unsharing first.
+	// Region views share the buffer of their parent, so the parent is copied instead.
+	// Jobs on texture views are always finished before returning, so they are not copied.
+	if ( ! source->isView() )
+		input = source->isRegion() ? source->getParent()->copy() : source->copy();
+	return job;
+}
+
+ForeignFunc::Result
+CuBridge::image_run( Cu::FFIServices&  ffi ) {
+	Cu::Object*  result;
+	Cu::Object*  input;
+	Image*  output;
+	ImageJob*  job = createImageJob(ffi, false, result, input, output);
+	if ( !job )
 		return ForeignFunc::NONFATAL;
+
+	getImagePool().runUntilDone(job);
+	delete job;
+	ffi.setResult(result);
+	result->deref();
+	if ( input )
+		input->deref();
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::image_job( Cu::FFIServices&  ffi ) {
+	Cu::Object*  result;
+	Cu::Object*  input;
+	Image*  output;
+	ImageJob*  job = createImageJob(ffi, true, result, input, output);
+	if ( !job )
+		return ForeignFunc::NONFATAL;
+
+	if ( ((Image&)ffi.arg(1)).isView() ) {
+		// A texture view could be unlocked while the job runs, so it is finished first
+		getImagePool().runUntilDone(job);
+	} else {
+		getImagePool().submit(job);
 	}
+	ffi.setNewResult( new ImageJobHandle(job, result, input, output) );
+	result->deref();
+	if ( input )
+		input->deref();
+	if ( output )
+		output->deref();
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::job_wait( Cu::FFIServices&  ffi, ImageJobHandle&  handle ) {
+	getImagePool().runUntilDone(handle.getJob(), true);
+	handle.finish();
+	ffi.setResult( handle.getResult() );
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::image_load_async( Cu::FFIServices&  ffi, Cu::StringObject&  path, Optional<Cu::FunctionObject&>  callback ) {
+	irr::core::array<util::String>  names;
+	names.push_back( path.getString() );
+	ImageLoad*  load = startImageLoad( names, false, callback.isSet() ? &(callback.get()) : REAL_NULL );
+	ffi.setNewResult(load);
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::texture_preload( Cu::FFIServices&  ffi ) {
+	const Cu::UInteger  count = ffi.getArgCount();
+	Cu::FunctionObject*  callback = REAL_NULL;
+	Cu::UInteger  pathCount = count;
+	Cu::UInteger  i = 0;
+	irr::core::array<util::String>  names;
+
+	if ( count > 0 && ffi.arg(count - 1).getType() == Cu::ObjectType::Function ) {
+		callback = (Cu::FunctionObject*)&(ffi.arg(count - 1));
+		--pathCount;
+	}
+	if ( pathCount == 0 ) {
+		ffi.demandArgCountRange(1, 2); // Reports the error
+		return ForeignFunc::NONFATAL;
+	}
+	for (; i < pathCount; ++i) {
+		if ( !ffi.demandArgType(i, Cu::ObjectType::String) )
+			return ForeignFunc::NONFATAL;
+	}
+
+	names.reallocate(pathCount);
+	for (i = 0; i < pathCount; ++i) {
+		const util::String&  name = ((Cu::StringObject&)ffi.arg(i)).getString();
+		// Cached textures need not be decoded again
+		if ( ! textureManager->find(name) )
+			names.push_back(name);
+	}
+	ffi.setNewResult( startImageLoad(names, true, callback) );
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::load_done( Cu::FFIServices&  ffi, ImageLoad&  load ) {
+	// The results are left to pumpLoads() so that its upload limit holds
+	ffi.setNewResult( new Cu::BoolObject( load.isRead() ) );
+	return ForeignFunc::FINISHED;
+}
 
-	image_t*  img = ((Image&)ffi.arg(0)).getImage();
-	util::String  name = ((Cu::StringObject&)ffi.arg(1)).getString();
+ForeignFunc::Result
+CuBridge::load_wait( Cu::FFIServices&  ffi, ImageLoad&  load ) {
+	getImagePool().runUntilDone( load.getBatch(), true );
+	if ( !load.isFinished() )
+		load.finish(*this);
+	if ( load.getResult() )
+		ffi.setResult( load.getResult() );
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::image_to_texture( Cu::FFIServices&  ffi, Image&  image, Cu::StringObject&  texName ) {
+	image_t*  img = image.getImage();
+	if ( !img ) {
+		return ForeignFunc::NONFATAL;
+	}
+	util::String  name = texName.getString();
 
+	// The pixels of a region view are not contiguous, so they are copied into an image of their own
+	if ( image.isRegion() ) {
+		img = createImageCopy( image, img->getColorFormat() );
+	} else {
+		img->grab();
+	}
 	texture_t*  tex = guiEnvironment->getVideoDriver()->addTexture( name.c_str(), img );
-	if ( tex )
+	img->drop();
+	if ( tex ) {
+		textureManager->add(name, tex);
 		ffi.setNewResult( new Texture(tex) );
+		// The texture starts with the whole image, so texture_update() only needs later changes
+		image.clearDirty();
+	}
 
 	return ForeignFunc::FINISHED;
 }
 
 ForeignFunc::Result
-CuBridge::texture_remove_from_driver( Cu::FFIServices& ffi )
-{
-	if ( !ffi.demandArgType(0, Texture::getTypeAsCuType()) )
-	{
+CuBridge::texture_remove_from_driver( Cu::FFIServices&, Texture&  texture ) {
+	texture_t*  tex = texture.getTexture();
+	if ( tex )
+		textureManager->remove(tex);
+
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::texture_trim( Cu::FFIServices&  ffi, Optional<Cu::NumericObject&>  budget ) {
+	irr::u32  removed;
+	if ( budget.isSet() ) {
+		const Cu::Integer  b = budget.get().getIntegerValue();
+		removed = textureManager->trim( b > 0 ? (size_t)b : 0 );
+	} else {
+		removed = textureManager->trim();
+	}
+	ffi.setNewResult( new Cu::IntegerObject( (Cu::Integer)removed ) );
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::texture_budget( Cu::FFIServices&  ffi, Optional<Cu::NumericObject&>  setting ) {
+	if ( setting.isSet() ) {
+		const Cu::Integer  b = setting.get().getIntegerValue();
+		textureManager->setBudget( b > 0 ? (size_t)b : 0 );
+	}
+	ffi.setNewResult( new Cu::IntegerObject( (Cu::Integer)textureManager->getBudget() ) );
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::texture_stats( Cu::FFIServices&  ffi, Optional<Cu::FunctionObject&>  storage ) {
+	if ( storage.isSet() ) {
+		Marshal<TextureStats>::toCopper( TextureStats::from(textureManager), &(storage.get()) );
+		ffi.setResult( &(storage.get()) );
+	} else {
+		ffi.setNewResult( Marshal<TextureStats>::toCopper( TextureStats::from(textureManager) ) );
+	}
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::texture_lock( Cu::FFIServices&  ffi, Texture&  texture ) {
+	Image*  view = texture.lock( guiEnvironment->getVideoDriver() );
+	if ( !view ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::TextureLockFailed );
 		return ForeignFunc::NONFATAL;
 	}
-	
-	texture_t*  tex = ((Texture&)ffi.arg(0)).getTexture();
-	if ( tex )
-		guiEnvironment->getVideoDriver()->removeTexture(tex);
+	ffi.setResult(view);
+	return ForeignFunc::FINISHED;
+}
 
+ForeignFunc::Result
+CuBridge::texture_unlock( Cu::FFIServices&, Texture&  texture ) {
+	texture.unlock();
 	return ForeignFunc::FINISHED;
 }
 
 texture_t*
 CuBridge::getTexture( util::String&  pathStr ) {
+	std::lock_guard<std::mutex>  lock( getImageDecodeLock() );
 	return guiEnvironment->getVideoDriver()->getTexture( CuStrToIrrPath(pathStr) );
 }
 
+image_t*
+CuBridge::loadImage( util::String&  pathStr ) {
+	std::lock_guard<std::mutex>  lock( getImageDecodeLock() );
+	return guiEnvironment->getVideoDriver()->createImageFromFile( CuStrToIrrPath(pathStr) );
+}
+
+bool
+CuBridge::canDecodeAsync( util::String& ) {
+	return true;
+}
+
 ForeignFunc::Result
-CuBridge::texture_access( Cu::FFIServices& ffi ) {
-	// Other arguments are ignored
-	if ( !ffi.demandArgType(0, Cu::ObjectType::String) )
+CuBridge::atlas_create( Cu::FFIServices&  ffi, Cu::NumericObject&  widthValue, Optional<Cu::NumericObject&>  heightValue ) {
+	Cu::Integer  width = widthValue.getIntegerValue();
+	Cu::Integer  height = heightValue.isSet() ? heightValue.get().getIntegerValue() : width;
+	if ( width <= 0 || height <= 0 ) {
+		return ForeignFunc::NONFATAL;
+	}
+	video_driver_t*  driver = guiEnvironment->getVideoDriver();
+	const core::dimension2du  maxSize = driver->getMaxTextureSize();
+	if ( (irr::u32)width > maxSize.Width || (irr::u32)height > maxSize.Height ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::AtlasTooLarge );
 		return ForeignFunc::NONFATAL;
+	}
+	ffi.setNewResult( new Atlas( driver, *textureManager, core::dimension2du( (irr::u32)width, (irr::u32)height ) ) );
+	return ForeignFunc::FINISHED;
+}
 
-	Cu::StringObject&  pathName = (Cu::StringObject&)ffi.arg(0);
-	texture_t* tex = getTexture( pathName.getString() );
+ForeignFunc::Result
+CuBridge::atlas_add( Cu::FFIServices&  ffi, Atlas&  atlas, Cu::Object&  source ) {
+	rect_t  placed;
+	bool  added;
+
+	if ( source.getType() == Cu::ObjectType::String ) {
+		util::String  path = ((Cu::StringObject&)source).getString();
+		const rect_t*  found = atlas.findFile(path);
+		if ( found ) {
+			ffi.setNewResult( new Sprite(atlas, *found) );
+			return ForeignFunc::FINISHED;
+		}
+		image_t*  img = loadImage(path);
+		if ( !img ) {
+			ffi.printCustomWarningCode( CuBridgeMessageCode::AtlasImageNotLoaded );
+			return ForeignFunc::NONFATAL;
+		}
+		added = atlas.addFile(path, img, placed);
+		img->drop();
+	}
+	else if ( ffi.demandArgType(1, Image::getTypeAsCuType()) ) {
+		Image&  image = (Image&)source;
+		if ( !image.getImage() ) {
+			ffi.printCustomWarningCode( CuBridgeMessageCode::AtlasImageNotLoaded );
+			return ForeignFunc::NONFATAL;
+		}
+		added = atlas.add(image.getImage(), image.getRegion(), placed);
+	}
+	else {
+		return ForeignFunc::NONFATAL;
+	}
+
+	if ( !added ) {
+		ffi.printCustomWarningCode( CuBridgeMessageCode::AtlasFull );
+		return ForeignFunc::NONFATAL;
+	}
+	ffi.setNewResult( new Sprite(atlas, placed) );
+	return ForeignFunc::FINISHED;
+}
+
+ForeignFunc::Result
+CuBridge::texture_access( Cu::FFIServices& ffi, Cu::StringObject& pathName ) {
+	texture_t* tex = textureManager->find( pathName.getString() );
+	if ( ! tex ) {
+		tex = getTexture( pathName.getString() );
+		if ( tex )
+			textureManager->add( pathName.getString(), tex );
+	}
 	if ( tex )
 		ffi.setNewResult( new Texture(tex) );
 	return ForeignFunc::FINISHED;
@@ -10,6 +10,11 @@
 #include <IGUIEnvironment.h> // from Irrlicht
 #include <Copper.h>
 #include "cubr_base.h"
+#include "cubr_setattr.h"
+#include "cubr_hotattr.h"
+#include "cubr_ffibind.h"
+#include "cubr_texmgr.h"
+#include "cubr_router.h"
 #ifdef INCLUDE_CUBR_JSON
 #include "json/cubr_json.h"
 #endif
@@ -18,6 +23,12 @@ namespace cubr {
 
 using Cu::ForeignFunc;
 
+class ThreadPool;
+class ImageJob;
+class ImageJobHandle;
+class Atlas;
+class ImageLoad;
+
 //! Copper Bridge
 /*
 	The main class for wrapping the engine and adding functionality.
@@ -28,6 +39,16 @@ protected:
 	Cu::Engine&  engine;
 	gui_environment_t*  guiEnvironment;
 	gui_element_t*  rootElement;
+	AttributeSetterTable  attributeSetters;
+	HotAttributeTable  hotAttributes;
+	bool  useNativeGeometry;
+	irr::u32  imageThreadCount;
+	ThreadPool*  imagePool; // Created when first needed
+	TextureManager*  textureManager; // Shared with atlases
+	irr::core::array<ImageLoad*>  pendingLoads; // Loads that are decoding or whose callbacks have not run
+	GUIEventQueue*  eventQueue; // Given to new GUI watchers and the event router. Not owned.
+	EventRouter  eventRouter;
+	bool  eventRouterInstalled;
 #ifdef INCLUDE_CUBR_JSON
 	json::Hub jsonHub;
 #endif
@@ -37,10 +58,21 @@ public:
 	struct InitFlags {
 		bool  enableImageModifying;
 		bool  enableJSON;
+		// Return rectangles, positions, dimensions, matrices, etc. as cubr geometry objects (see cubr_geom.h)
+		// rather than functions with members. Both forms are always accepted.
+		bool  nativeGeometry;
+		// Number of threads used by image_run() and image_job(). Zero uses the number of hardware threads.
+		irr::u32  imageThreads;
+		// Bytes of texture memory that get_texture() and image_to_texture() may keep before the textures
+		// no longer used by a cubrtex or GUI element are removed from the video driver. Zero is no limit.
+		size_t  textureBudget;
 
 		InitFlags()
 			: enableImageModifying(false)
 			, enableJSON(false)
+			, nativeGeometry(false)
+			, imageThreads(0)
+			, textureBudget(0)
 		{}
 	};
 
@@ -54,15 +86,67 @@ public:
 
 	virtual ~CuBridge();
 
+	// Owns the image thread pool (deleted by the destructor), so it cannot be copied
+	CuBridge( const CuBridge& ) = delete;
+
+	CuBridge&
+	operator=( const CuBridge& ) = delete;
+
 	Cu::Engine&
 	getCuEngine();
 
+	// Setters used by gui_set() and gui_value()
+	// Add to this table to give custom GUI elements fast attribute setting.
+	AttributeSetterTable&
+	getAttributeSetters();
+
+	// Getters used by gui_value() for the commonly polled attributes of each element type
+	HotAttributeTable&
+	getHotAttributes();
+
+	// Pool for running image jobs
+	ThreadPool&
+	getImagePool();
+
+	// Cache of the textures from get_texture() and image_to_texture()
+	TextureManager&
+	getTextureManager();
+
+	// Call once per frame when using image_load_async() or texture_preload().
+	// Creates the images and textures of the files that have been decoded (at most maxUploads of them, zero for no limit)
+	// and runs the callbacks of finished loads. Returns the number of loads still pending.
+	irr::u32
+	pumpLoads( irr::u32  maxUploads = 0 );
+
+	// Queue used by the event router and GUI watchers created after this call for coalescing their events
+	// (normally that of the EventHandler, see EventHandler::getEventQueue()). Null runs their callbacks immediately.
+	// The queue must outlive the watchers.
+	void
+	setEventQueue( GUIEventQueue* );
+
+	// Router of the callbacks set with gui_on()
+	EventRouter&
+	getEventRouter();
+
+	// Makes the event router the user event receiver of the GUI environment, so that gui_on() callbacks are run.
+	// Call after IrrlichtDevice::setEventReceiver() (which replaces the GUI environment receiver) and give it the
+	// device receiver, which is then passed the GUI events not handled by the router.
+	// Alternatively, call getEventRouter().OnEvent() from the application's own receiver.
+	// The GUI environment is grabbed until the router is uninstalled.
+	void
+	installEventRouter( irr::IEventReceiver*  next );
+
+	// Gives the GUI environment back the receiver passed to installEventRouter(). Also done by the destructor.
+	// Irrlicht cannot tell which receiver the environment has, so call this before giving the environment another receiver.
+	void
+	uninstallEventRouter();
+
 	// Set the GUI environment a new root GUI element
 	void
 	setGUIEnvironment( gui_environment_t*  env, gui_element_t*  root=nullptr);
 
 	// Methods added to the Copper as foreign functions
-	// (Added via addForeignMethodInstance())
+	// (Added via addForeignMethodInstance(), or bindFFI() for those taking their arguments as parameters)
 		// GUI element methods
 			// gui_root()
 	ForeignFunc::Result  gui_getRoot( Cu::FFIServices& );
@@ -72,45 +156,51 @@ public:
 	ForeignFunc::Result  gui_new_empty( Cu::FFIServices& );
 			// gui_watcher( info: )
 	ForeignFunc::Result  gui_watcher( Cu::FFIServices& );
+			// gui_on( element: event_type: [callback:] ) // Without a callback, removes the callback for the event type
+	ForeignFunc::Result  gui_on( Cu::FFIServices&, GUIElement&, Cu::StringObject&, Optional<Cu::FunctionObject&> );
 			// Instantiation of attributes of a single GUI element
 			// gui_instantiate( element: info: )
 	ForeignFunc::Result  gui_instantiate( Cu::FFIServices& );
-			// gui_attrs( element: )
+			// gui_attrs( element: [attributes:] )
+			// gui_attrs( element: "name" [, "name"...] ) // Returns only the named attributes
 	ForeignFunc::Result  gui_allAttributes( Cu::FFIServices& );
 			// Returns serialized values for the most commonly-changed attributes.
 			// For some elements, this returns all attributes anyways.
 			// gui_value( element: )
 	ForeignFunc::Result  gui_value( Cu::FFIServices& );
+			// Sets only the given attributes, using the setters of the element where possible.
+			// gui_set( element: attributes: )
+	ForeignFunc::Result  gui_set( Cu::FFIServices&, GUIElement&, Cu::FunctionObject& );
 			// Returns serialized values for all attributes specific to an element (but not inherited attributes)
 			// gui_specifics( element: )
 	//ForeignFunc::Result gui_specifics( Cu::FFIServices& );
 			// gui_parent( element: [parent:] )
-	ForeignFunc::Result  gui_parent( Cu::FFIServices& );
+	ForeignFunc::Result  gui_parent( Cu::FFIServices&, GUIElement&, Optional<GUIElement&> );
 			// gui_child_with_id( element: child_id: )
-	ForeignFunc::Result  gui_child_with_id( Cu::FFIServices& );
+	ForeignFunc::Result  gui_child_with_id( Cu::FFIServices&, GUIElement&, Cu::NumericObject& );
 			// gui_child_at_index( element: child_index: )
 	//ForeignFunc::Result gui_child_at_index( Cu::FFIServices& );
 			// gui_add_child( element: child_element: )
-	ForeignFunc::Result  gui_add_child( Cu::FFIServices& );
+	ForeignFunc::Result  gui_add_child( Cu::FFIServices&, GUIElement&, GUIElement& );
 			// gui_remove_child( element: child_element: )
-	ForeignFunc::Result  gui_remove_child( Cu::FFIServices& );
+	ForeignFunc::Result  gui_remove_child( Cu::FFIServices&, GUIElement&, GUIElement& );
 			// gui_remove_children( element: )
 	ForeignFunc::Result  gui_remove_children( Cu::FFIServices& );
 			// gui_type( element: ) // Returns integer value casted from enum or a string name
 	// TODO
 			// gui_to_front( element: )
-	ForeignFunc::Result  gui_to_front( Cu::FFIServices& );
+	ForeignFunc::Result  gui_to_front( Cu::FFIServices&, GUIElement& );
 			// gui_enabled( element: [new value:] )
-	ForeignFunc::Result  gui_enabled( Cu::FFIServices& );
+	ForeignFunc::Result  gui_enabled( Cu::FFIServices&, GUIElement&, Optional<Cu::BoolObject&> );
 			// gui_visible( element: [new value:] )
-	ForeignFunc::Result  gui_visible( Cu::FFIServices& );
-			// gui_position( element: [new value:] ) // new value = [x, y, x2, y2]
-	ForeignFunc::Result  gui_position( Cu::FFIServices& );
+	ForeignFunc::Result  gui_visible( Cu::FFIServices&, GUIElement&, Optional<Cu::BoolObject&> );
+			// gui_position( element: [new value:] ) // new value = [x, y, x2, y2] or a cubrrect
+	ForeignFunc::Result  gui_position( Cu::FFIServices&, GUIElement&, Optional<Cu::Object&> );
 			// gui_id( element: [new value:] )
-	ForeignFunc::Result  gui_id( Cu::FFIServices& );
+	ForeignFunc::Result  gui_id( Cu::FFIServices&, GUIElement&, Optional<Cu::NumericObject&> );
 			// gui_text( element: [new value:] )
-	ForeignFunc::Result  gui_text( Cu::FFIServices& );
-			// gui_expand( element: )
+	ForeignFunc::Result  gui_text( Cu::FFIServices&, GUIElement&, Optional<Cu::StringObject&> );
+			// gui_expand( element: ) // Returns the new position of the last element when using native geometry
 	ForeignFunc::Result  gui_expand( Cu::FFIServices& );
 
 protected:
@@ -121,6 +211,9 @@ protected:
 	ForeignFunc::Result
 	gui_attributeSelector( Cu::FFIServices&, irr::io::SAttributeReadWriteOptions& );
 
+	ForeignFunc::Result
+	gui_attributeProjection( Cu::FFIServices&, irr::io::SAttributeReadWriteOptions& );
+
 public:
 	// Converts string values:
 	// "A1R5G5B5" = ECF_A1R5G5B5
@@ -132,22 +225,114 @@ public:
 			// image_create( width: height: [color_format_string:] ) - Default is "A8R8G8B8" (ECF_A8R8G8B8)
 	ForeignFunc::Result  image_create( Cu::FFIServices& );
 
-			// image_to_texture( image: )
-	ForeignFunc::Result  image_to_texture( Cu::FFIServices& );
+			// image_convert( image: color_format_string: ) - Returns a copy of the image in the given format
+	ForeignFunc::Result  image_convert( Cu::FFIServices&, Image&, Cu::StringObject& );
+
+			// image_to_texture( image: texture_name: )
+	ForeignFunc::Result  image_to_texture( Cu::FFIServices&, Image&, Cu::StringObject& );
 	
 			// texture_remove_from_driver( texture: )
 	// By default, textures are added to the video driver via image_to_texture()
-	// but they must be manually removed via this method to save memory because
-	// they are not removed when simply destroying the Copper texture object
-	ForeignFunc::Result  texture_remove_from_driver( Cu::FFIServices& );
+	// and stay there until removed via this method or, when there is a texture budget,
+	// until they are no longer used and the texture manager needs the memory.
+	ForeignFunc::Result  texture_remove_from_driver( Cu::FFIServices&, Texture& );
+
+			// texture_trim( [budget:] )
+	// Removes the textures no longer used until the cached textures fit in the budget
+	// (default is InitFlags::textureBudget). Returns the number of textures removed.
+	ForeignFunc::Result  texture_trim( Cu::FFIServices&, Optional<Cu::NumericObject&> );
 
+			// texture_budget( [bytes:] )
+	// Sets (if given) and returns the texture budget. Zero is no limit.
+	ForeignFunc::Result  texture_budget( Cu::FFIServices&, Optional<Cu::NumericObject&> );
+
+			// texture_stats( [storage:] )
+	// Returns an object with members textures, used, bytes, budget, hits, misses and evictions.
+	ForeignFunc::Result  texture_stats( Cu::FFIServices&, Optional<Cu::FunctionObject&> );
+
+			// texture_lock( texture: )
+	// Returns a cubrimage that views the texture memory directly, so the image functions change the texture
+	// without a copy. The view is emptied by texture_unlock(), and the texture cannot be drawn while locked.
+	ForeignFunc::Result  texture_lock( Cu::FFIServices&, Texture& );
+
+			// texture_unlock( texture: )
+	ForeignFunc::Result  texture_unlock( Cu::FFIServices&, Texture& );
+
+			// atlas_create( width: [height:] ) - Height defaults to the width
+	// Returns a cubratlas for packing many images into one texture.
+	ForeignFunc::Result  atlas_create( Cu::FFIServices&, Cu::NumericObject&, Optional<Cu::NumericObject&> );
+
+			// atlas_add( atlas: path_or_image: )
+	// Copies the image (or the file image, loaded once per path) into the atlas and returns a cubrsprite,
+	// or nothing if there is no room.
+	ForeignFunc::Result  atlas_add( Cu::FFIServices&, Atlas&, Cu::Object& );
+
+			// image_load_async( path: [callback:] )
+	// Reads and decodes the image file on the image thread pool and returns a cubrload. pumpLoads() then makes the
+	// load result, a cubrimage. The callback is run by pumpLoads() with the load as its argument.
+	ForeignFunc::Result  image_load_async( Cu::FFIServices&, Cu::StringObject&, Optional<Cu::FunctionObject&> );
+
+			// texture_preload( path: [path: ...] [callback:] )
+	// Reads and decodes the image files on the image thread pool and returns a cubrload. pumpLoads() uploads them as
+	// textures and adds them to the texture manager, so get_texture() finds them without loading.
+	// The load result is the number of textures loaded.
+	ForeignFunc::Result  texture_preload( Cu::FFIServices& );
+
+			// load_done( load: )
+	// Returns true if the files are decoded. The results are created by pumpLoads() (or load_wait()).
+	ForeignFunc::Result  load_done( Cu::FFIServices&, ImageLoad& );
+
+			// load_wait( load: )
+	// Helps decode the files until done and returns the load result.
+	ForeignFunc::Result  load_wait( Cu::FFIServices&, ImageLoad& );
+
+			// Runs a kernel over the image in tiles on the image thread pool and returns the resulting image.
+			// image_run( "fill" image: color: )
+			// image_run( "gradient" image: color: color: [vertical:] )
+			// image_run( "color_matrix" image: floats: ) // 4x4 cubrfloats
+			// image_run( "convert" image: color_format_string: ) // Returns a new image
+			// image_run( "resample" image: width: height: ) // Returns a new image
+	ForeignFunc::Result  image_run( Cu::FFIServices& );
+
+			// Same arguments as image_run(), but returns a cubrjob without waiting for the kernel to finish
+			// image_job( kernel_name: image: ... )
+	ForeignFunc::Result  image_job( Cu::FFIServices& );
+
+			// Helps run the job until it is done and returns its image
+			// job_wait( job: )
+	ForeignFunc::Result  job_wait( Cu::FFIServices&, ImageJobHandle& );
+
+protected:
+	// Creates the job for image_run() and image_job() from the args or returns null if they are invalid.
+	// Result receives the image object the job writes to and input a copy of the source image, if any.
+	// If deferred is set, kernels that change the given image write into output, a private copy of it
+	// (see ImageJobHandle::finish()). Texture views are never copied.
+	// The caller must deref result, input and output.
+	ImageJob*
+	createImageJob( Cu::FFIServices&, bool  deferred, Cu::Object*&  result, Cu::Object*&  input, Image*&  output );
+
+	// Submits a load of the files to the image thread pool and adds it to the pending loads.
+	ImageLoad*
+	startImageLoad( const irr::core::array<util::String>&, bool  makeTextures, Cu::FunctionObject*  callback );
+
+public:
 		// Image and Texture methods
 	virtual texture_t*
 	getTexture( util::String&  pathStr ); // Override to prohibit
 
+	// Used for loading images into atlases, on the main thread. The caller must drop the image.
+	// image_load_async() and texture_preload() use this and getTexture() for files not decoded on the thread pool.
+	virtual image_t*
+	loadImage( util::String&  pathStr ); // Override to prohibit
+
+	// Whether image_load_async() and texture_preload() may decode the file on the image thread pool
+	// with the image loaders of the video driver rather than load it with loadImage() or getTexture().
+	virtual bool
+	canDecodeAsync( util::String&  pathStr ); // Override to prohibit
+
 			// get_texture( path: )
 	virtual ForeignFunc::Result
-	texture_access( Cu::FFIServices& );
+	texture_access( Cu::FFIServices&, Cu::StringObject& );
 };
 
 }